@@ -12,6 +12,9 @@ if [%OPT%] == [] (
 	set "OPT=-O0"
 	REM -fgcse-sm -fgcse-las -fgcse-after-reload"
 )
+if not defined PEEPHOLE (
+	set PEEPHOLE=1
+)
 call :main %TARGET% "%OPT%"
 exit /B %ERRORLEVEL%
 
@@ -53,6 +56,7 @@ exit /B 0
 	call :remove .\%FOLDER%\*.s19
 	call :remove .\%FOLDER%\*.bin
 	call :remove .\%FOLDER%\*.cnt
+	call :remove .\%FOLDER%\*.cyc
 exit /B 0
 
 :clean
@@ -85,6 +89,10 @@ exit /B 0
 	setlocal enableextensions enabledelayedexpansion
 	set FILE=%1
 	set FOLDER=%2
+	if %PEEPHOLE% == 0 (
+		echo peephole optimization switched off for %FILE%.s
+		exit /B 0
+	)
 	%GCC%\optimize\rxrepl --no-backup --return-count -f .\%FOLDER%\%FILE%.s -a  --options %GCC%\optimize\rules_optimize.txt
 	echo %ERRORLEVEL% line(s) optimized in %FILE%.s
 exit /B %ERRORLEVEL%
@@ -222,6 +230,41 @@ exit /B 0
 	call :build %PROJECT%
 exit /B 0
 
+:make_wcet - PROJECT OPT
+	set PROJECT=%1
+	set "OPT=%2"
+	call :make_build %PROJECT% "%OPT%"
+	call :separator
+	echo analysing worst case frame time of project %PROJECT% ...
+	python .\tools\wcet.py --build .\build\lib --options=%OPT% -D TICKS=1 --budget 30000 || exit /B 1
+	python .\tools\wcet.py --build .\build\lib --options=%OPT% -D TICKS=2 --budget 33750 || exit /B 1
+exit /B 0
+
+:make_footprint - PROJECT OPT
+	set PROJECT=%1
+	set "OPT=%2"
+	call :make_build %PROJECT% "%OPT%"
+	call :separator
+	echo checking rom / ram footprint of project %PROJECT% ...
+	python .\tools\footprint.py --map .\build\%PROJECT%.map --symbols || exit /B 1
+exit /B 0
+
+:make_stack - PROJECT OPT
+	set PROJECT=%1
+	set "OPT=%2"
+	call :make_build %PROJECT% "%OPT%"
+	call :separator
+	echo analysing stack depth of project %PROJECT% ...
+	python .\tools\stack.py --build .\build\lib --map .\build\%PROJECT%.map || exit /B 1
+exit /B 0
+
+:make_bench - PROJECT
+	set PROJECT=%1
+	call :separator
+	echo benchmarking optimization profiles of project %PROJECT% ...
+	python .\tools\bench.py --functions || exit /B 1
+exit /B 0
+
 :make_lint - PROJECT
 	set PROJECT=%1
 	set FILES=%GCC%\vectrex\include\*.h %GCC%\vectrex\source\*.c
@@ -271,12 +314,20 @@ exit /B 0
 		@call :make_link %PROJECT% "%OPT%"
 	) else if %TARGET% == build (
 		@call :make_build %PROJECT% "%OPT%"
+	) else if %TARGET% == wcet (
+		@call :make_wcet %PROJECT% "%OPT%" || exit /B 1
+	) else if %TARGET% == footprint (
+		@call :make_footprint %PROJECT% "%OPT%" || exit /B 1
+	) else if %TARGET% == stack (
+		@call :make_stack %PROJECT% "%OPT%" || exit /B 1
+	) else if %TARGET% == bench (
+		@call :make_bench %PROJECT% || exit /B 1
 	) else if %TARGET% == lint (
 		@call :make_lint %PROJECT%
 	) else if %TARGET% == run (
 		@call :make_run %PROJECT%
 	) else (
-		@echo ERROR - unknown target: clean, preprocess, compile, optimize, assemble, link, build, lint, run
+		@echo ERROR - unknown target: clean, preprocess, compile, optimize, assemble, link, build, wcet, footprint, stack, bench, lint, run
 		@exit /B 1
 	)
 	call :separator
@@ -299,6 +350,6 @@ exit /B 0
 		@echo ERROR - could not determine project name
 		@exit /B 1		
 	) else (
-		call :make %TARGET% %PROJECT% "%OPT%"
+		call :make %TARGET% %PROJECT% "%OPT%" || exit /B 1
 	)
 exit /B 0
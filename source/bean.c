@@ -6,6 +6,11 @@
 
 #include "bean.h"
 #include "ground.h"
+#include "particle.h"
+#include "pyoro.h"
+#include "geometry.h"
+#include "utils/utils.h"
+#include "utils/perf.h"
 
 // ---------------------------------------------------------------------------
 // constant data for the bean's vectors
@@ -20,92 +25,293 @@ const int vectors_bean[] =
 	1
 };
 
-// ---------------------------------------------------------------------------
-// look-up table of bean position
-const int xpos[] = 
-{
-	-120,
-	-104,
-	-88,
-	-72,
-	-56,
-	-40,
-	-24,
-	-8,
-	8,
-	24,
-	40,
-	56,
-	72,
-	88,
-	104,
-	120
-	
+// bean with a horizontal bar
+const int vectors_bean_restore[] =
+{
+	0,0,-100,
+	-1,100,100,
+	-1,-100,100,
+	-1,-100,-100,
+	-1,100,-100,
+	-1,0,100,
+	-1,0,100,
+	1
+};
+
+// bean with a cross
+const int vectors_bean_clear[] =
+{
+	0,0,-100,
+	-1,100,100,
+	-1,-100,100,
+	-1,-100,-100,
+	-1,100,-100,
+	-1,0,100,
+	-1,0,100,
+	0,100,-100,
+	-1,-100,0,
+	-1,-100,0,
+	1
 };
 
 // ---------------------------------------------------------------------------
-// global variable for the bean's sprite
+// fall speed per height band, index 0 = bottom, 7 = top of the screen
+
+const int speed_normal[8] = {3, 3, 2, 2, 2, 2, 1, 1};
+const int speed_restore[8] = {2, 2, 2, 2, 1, 1, 1, 1};
+const int speed_clear[8] = {4, 3, 3, 3, 2, 2, 2, 2};
+
+// ---------------------------------------------------------------------------
+// global variables of the falling beans, a bean is on screen if its bit is
+// set in beans_live
+
+struct object beans[BEAN_COUNT];
+
+unsigned int beans_live = 0;
+
+unsigned int bean_timer = 0;
+
+const unsigned int bean_bits[BEAN_COUNT] = {0b0001, 0b0010, 0b0100, 0b1000};
+
+// beans moved ahead / drawn since the last update_beans(), see bean.h
+unsigned int beans_ahead = 0;
+unsigned int beans_drawn = 0;
+
+struct bean_plan_t bean_plan;
+
+// ---------------------------------------------------------------------------
+// a bean was shot: points and fragments
+
+void destroy_bean(unsigned int i)
+{
+	beans_live &= ~bean_bits[i];
+	perf_count(destroyed);
+	burst_particles(beans[i].coord.y, beans[i].coord.x);
+	score += bean_types[beans[i].type].points;
+}
+
+// ---------------------------------------------------------------------------
+// destroy every bean on screen with points; one pass over the live mask,
+// at most BEAN_COUNT beans, the kinds of the destroyed beans do not act
 
-struct object bean =
+void clear_beans()
 {
+	unsigned int live = beans_live;
+	unsigned int i;
+	for (i = 0; live; ++i)
 	{
-		{0, 0}	// coord.y, coord.x
-		
-	},
-	0,	// lane
-	2,	// speed
-	10,	// scale
-	0	// drawn
-	
+		if (live & bean_bits[i])
+		{
+			live &= ~bean_bits[i];
+			destroy_bean(i);
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// what happens when a bean is caught (lane of the catching player) or lands
+
+void catch_normal(unsigned int lane)
+{
+	(void) lane;
+}
+
+void catch_restore(unsigned int lane)
+{
+	restore_tiles(lane, BEAN_RESTORE_TILES);
+}
+
+void catch_clear(unsigned int lane)
+{
+	(void) lane;
+	clear_beans();
+}
+
+void land_break(struct object* b)
+{
+	break_tile(b->lane);
+	burst_particles(-115, b->coord.x);	// tile breaks
+	play_event(SOUND_BREAK);
+}
+
+// ---------------------------------------------------------------------------
+// bean kinds, indexed by BEAN_*
+
+const struct bean_type_t bean_types[BEAN_TYPES] =
+{
+	{ vectors_bean,			VECTORS(vectors_bean),			10,	speed_normal,	1,	catch_normal,	land_break },
+	{ vectors_bean_restore,	VECTORS(vectors_bean_restore),	10,	speed_restore,	2,	catch_restore,	land_break },
+	{ vectors_bean_clear,	VECTORS(vectors_bean_clear),	12,	speed_clear,	5,	catch_clear,	land_break },
+};
+
+// kind of a new bean, indexed by a random number
+const unsigned int bean_spawn_types[16] =
+{
+	BEAN_NORMAL, BEAN_NORMAL, BEAN_NORMAL, BEAN_RESTORE,
+	BEAN_NORMAL, BEAN_NORMAL, BEAN_NORMAL, BEAN_NORMAL,
+	BEAN_NORMAL, BEAN_NORMAL, BEAN_NORMAL, BEAN_RESTORE,
+	BEAN_NORMAL, BEAN_NORMAL, BEAN_NORMAL, BEAN_CLEAR
 };
 
 // ---------------------------------------------------------------------------
-// function to draw the bean in the screen
+// function to remove all beans, call at the start of a game
 
-void draw_bean()
+void init_beans()
 {
-	Reset0Ref();
-	VIA_t1_cnt_lo = 110;
-	Moveto_d(bean.coord.y,bean.coord.x);
-	VIA_t1_cnt_lo = bean.scale;
-	Draw_VLp(&vectors_bean);
-	
+	beans_live = 0;
+	bean_timer = 0;
+	beans_ahead = 0;
+	beans_drawn = 0;
+	bean_plan.planned = 0;
 }
 
 // ---------------------------------------------------------------------------
-// function to move the bean (falling)
+// function to draw the beans in the screen
 
-void move_bean()
+void draw_beans()
 {
-	bean.coord.y-=bean.speed;
-	
+	unsigned int i;
+	for (i = 0; i < BEAN_COUNT; ++i)
+	{
+		if (beans_live & bean_bits[i])
+		{
+			struct object* b = &beans[i];
+			const struct bean_type_t* type = &bean_types[b->type];
+			beam_reset();
+			beam_scale(110);
+			beam_move_begin(b->coord.y, b->coord.x);
+			bean_slice();
+			beam_move_end();
+			beam_scale(type->scale);
+			beam_vectors(type->sprite, type->vectors);
+			beans_drawn |= bean_bits[i];
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// fall of one bean for the tick, the height band is the top 3 bits of
+// y + 128
+
+static inline __attribute__((always_inline))
+void fall_bean(struct object* b)
+{
+	b->coord.y -= bean_types[b->type].speed[((unsigned int) b->coord.y ^ 0x80) >> 5];
+}
+
+// ---------------------------------------------------------------------------
+// lane and kind of the next bean
+
+void plan_spawn()
+{
+	bean_plan.lane = spawn_lanes[Random() & (SPAWN_LANES - 1)];
+	bean_plan.type = bean_spawn_types[Random() & 15];
+	bean_plan.planned = 1;
 }
 
 // ---------------------------------------------------------------------------
-// function to check the bean (hit the ground, etc)
+// one piece of the next tick's work, called while the beam moves (about
+// 110 cycles at scale 110): the fall of one bean already drawn this frame,
+// or else the random numbers of the next spawn
 
-void check_bean()
-{	
-	if(bean.coord.y < -110)
+void bean_slice()
+{
+	unsigned int todo = beans_live & beans_drawn & ~beans_ahead;
+	unsigned int i;
+	
+	if (todo)
+	{
+		for (i = 0; !(todo & bean_bits[i]); ++i)
+		{
+		}
+		fall_bean(&beans[i]);
+		beans_ahead |= bean_bits[i];
+		perf_count(slices);
+	}
+	else if (!bean_plan.planned)
 	{
-		ground_state[bean.lane] = 0;
-		bean.drawn = 0;
+		plan_spawn();
+		perf_count(slices);
 	}
 }
 
 // ---------------------------------------------------------------------------
 // function to spawn a bean on the top end of the screen
 
-void spawn_bean()
+void spawn_bean(unsigned int i)
 {
-	bean.coord.y = 120;
-	bean.lane = Random()%16;
-	bean.coord.x = xpos[bean.lane];//xpos[bean.lane];
-	bean.drawn = 1;
+	struct object* b = &beans[i];
+	if (!bean_plan.planned)
+	{
+		plan_spawn();
+	}
+	bean_plan.planned = 0;
+	b->coord.y = 120;
+	b->lane = bean_plan.lane;
+	b->coord.x = lane_centres[b->lane];
+	b->type = bean_plan.type;
+	beans_live |= bean_bits[i];
+	perf_count(spawned);
 	
 }
 
+// ---------------------------------------------------------------------------
+// function to move the beans (falling), let them land on the ground and
+// spawn new ones; beans moved ahead by bean_slice() only land
+
+void update_beans()
+{
+	unsigned int i;
+	unsigned int slot = BEAN_COUNT;
+	
+	for (i = 0; i < BEAN_COUNT; ++i)
+	{
+		if (beans_live & bean_bits[i])
+		{
+			struct object* b = &beans[i];
+			if (!(beans_ahead & bean_bits[i]))
+			{
+				fall_bean(b);
+			}
+			
+			// hit the ground
+			if(b->coord.y < -110)
+			{
+				beans_live &= ~bean_bits[i];
+				perf_count(destroyed);
+				bean_types[b->type].on_land(b);
+			}
+		}
+		else
+		{
+			slot = i;
+		}
+	}
+	beans_ahead = 0;
+	beans_drawn = 0;
 	
+	if (bean_timer)
+	{
+		--bean_timer;
+	}
+	if (slot != BEAN_COUNT && (!beans_live || !bean_timer))
+	{
+		spawn_bean(slot);
+		bean_timer = BEAN_INTERVAL;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// bean i was caught by a player on lane: points, fragments, then whatever
+// its kind does
+
+void catch_bean(unsigned int i, unsigned int lane)
+{
+	destroy_bean(i);
+	play_event(SOUND_CATCH);
+	bean_types[beans[i].type].on_catch(lane);
+}
+
 // ***************************************************************************
 // end of file
 // ***************************************************************************
@@ -6,14 +6,59 @@
 #include "types.h"
 
 // ---------------------------------------------------------------------------
+// bean kinds, every live bean stores only its index into bean_types[];
+// everything that is the same for all beans of a kind lives in rom
 
-extern struct object bean;
+#define BEAN_NORMAL		0	// breaks a tile when it lands
+#define BEAN_RESTORE	1	// restores a tile when caught
+#define BEAN_CLEAR		2	// destroys all beans on screen when caught
+#define BEAN_TYPES		3
 
-//void init_bean();
-void move_bean();
-void draw_bean();
-/*int*/ void check_bean();
-void spawn_bean();
+#define BEAN_COUNT		4	// beans on screen at the same time
+#define BEAN_INTERVAL	50	// frames between two spawns
+#define BEAN_RESTORE_TILES	1	// tiles rebuilt by a caught BEAN_RESTORE
+
+struct bean_type_t
+{
+	const int* sprite;				// Draw_VLp() vector list
+	unsigned int vectors;			// vectors of sprite, see utils/vectors.h
+	unsigned int scale;
+	const int* speed;				// fall speed per height band, see update_beans()
+	unsigned int points;
+	void (*on_catch)(unsigned int lane);	// lane of the catching player
+	void (*on_land)(struct object* b);
+};
+
+// ---------------------------------------------------------------------------
+// work done ahead while the beam moves (bean_slice()): a bean drawn this
+// frame may already fall for the next tick, its bit in beans_ahead tells
+// update_beans() to skip the move; the lane and kind of the next spawn may
+// be drawn from Random() ahead, nothing else uses the random numbers, so
+// the game plays exactly as without the slices; a frame without a tick
+// (utils/pace.h) shows a bean moved ahead one tick early
+
+struct bean_plan_t
+{
+	unsigned int planned;
+	unsigned int lane;
+	unsigned int type;
+};
+
+extern const struct bean_type_t bean_types[BEAN_TYPES];
+extern struct object beans[BEAN_COUNT];
+extern unsigned int beans_live;
+extern unsigned int bean_timer;
+extern const unsigned int bean_bits[BEAN_COUNT];
+extern unsigned int beans_ahead;
+extern unsigned int beans_drawn;
+extern struct bean_plan_t bean_plan;
+
+void init_beans();
+void update_beans();
+void draw_beans();
+void bean_slice();
+void catch_bean(unsigned int i, unsigned int lane);
+void clear_beans();
 
 // ***************************************************************************
 // end of file
@@ -4,6 +4,9 @@
 
 #include <vectrex.h>
 
+#include "config.h"
+#include "utils/sound.h"
+
 // ---------------------------------------------------------------------------
 
 struct cartridge_t
@@ -22,7 +25,13 @@ struct cartridge_t
 const struct cartridge_t game_header __attribute__((section(".cartridge"), used)) = 
 {
 	.copyright 		= "g GCE 2018\x80",
+#if FAST_BOOT
+	// the bios keeps the title screen up while the title music plays,
+	// a silent tune ends it as early as the bios allows
+	.music 			= &music_off,
+#else
 	.music 			= &Vec_Music_1,
+#endif
 	.title_height 	= -8,
 	.title_width 	= 80,
 	.title_y 		= 16,
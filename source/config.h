@@ -0,0 +1,36 @@
+// ***************************************************************************
+// config
+// ***************************************************************************
+
+#pragma once
+
+// ---------------------------------------------------------------------------
+// build switches, pass -D NAME=1 as optimization option to make.bat to
+// enable them, e.g. make build "-O0 -D TRACE=1"
+// release builds leave all of them switched off
+
+// debug builds: frame budget overlay, toggled with button 3 of controller 1
+#ifndef DEBUG
+#define DEBUG 0
+#endif
+
+// test cycles: shorten the bios title screen (cartridge.c) and restart a
+// warm reset straight into gameplay (main.c)
+#ifndef FAST_BOOT
+#define FAST_BOOT 0
+#endif
+
+// record every beam operation of a frame for the harness (utils/trace.h)
+#ifndef TRACE
+#define TRACE 0
+#endif
+
+// playfield lanes (tiles of the floor), 16 or up to 30 like the original
+// game; widths and tables follow in geometry.h
+#ifndef LANES
+#define LANES 16
+#endif
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -0,0 +1,121 @@
+// ***************************************************************************
+// demo
+// ***************************************************************************
+
+#include <vectrex.h>
+
+#include "demo.h"
+#include "input.h"
+
+// ---------------------------------------------------------------------------
+// about 30 seconds of play, walking to a spot and catching from there
+
+const unsigned int demo_script[] =
+{
+	DEMO_RUN(INPUT_LEFT, 6), DEMO_RUN(INPUT_SHOOT, 10), DEMO_RUN(INPUT_LEFT, 21),
+	DEMO_RUN(INPUT_SHOOT, 5), DEMO_RUN(INPUT_SHOOT, 9), DEMO_RUN(INPUT_SHOOT, 13),
+	DEMO_RUN(0, 20), DEMO_RUN(INPUT_RIGHT, 11), DEMO_RUN(INPUT_SHOOT, 5),
+	DEMO_RUN(INPUT_LEFT, 11), DEMO_RUN(INPUT_SHOOT, 5), DEMO_RUN(INPUT_SHOOT, 5),
+	DEMO_RUN(INPUT_SHOOT, 7), DEMO_RUN(INPUT_SHOOT, 14), DEMO_RUN(INPUT_SHOOT, 13),
+	DEMO_RUN(INPUT_SHOOT, 10), DEMO_RUN(INPUT_SHOOT, 4), DEMO_RUN(INPUT_LEFT, 2),
+	DEMO_RUN(INPUT_SHOOT, 6), DEMO_RUN(INPUT_SHOOT, 8), DEMO_RUN(INPUT_SHOOT, 10),
+	DEMO_RUN(0, 7), DEMO_RUN(INPUT_RIGHT, 32), DEMO_RUN(INPUT_RIGHT, 12),
+	DEMO_RUN(INPUT_SHOOT, 12), DEMO_RUN(INPUT_SHOOT, 14), DEMO_RUN(0, 10),
+	DEMO_RUN(INPUT_LEFT, 16), DEMO_RUN(INPUT_SHOOT, 12), DEMO_RUN(INPUT_RIGHT, 15),
+	DEMO_RUN(INPUT_SHOOT, 13), DEMO_RUN(0, 17), DEMO_RUN(INPUT_RIGHT, 18),
+	DEMO_RUN(INPUT_SHOOT, 11), DEMO_RUN(INPUT_SHOOT, 13), DEMO_RUN(INPUT_LEFT, 32),
+	DEMO_RUN(INPUT_LEFT, 2), DEMO_RUN(INPUT_SHOOT, 7), DEMO_RUN(INPUT_SHOOT, 6),
+	DEMO_RUN(INPUT_LEFT, 10), DEMO_RUN(INPUT_SHOOT, 13), DEMO_RUN(INPUT_RIGHT, 20),
+	DEMO_RUN(INPUT_SHOOT, 11), DEMO_RUN(INPUT_SHOOT, 8), DEMO_RUN(INPUT_LEFT, 32),
+	DEMO_RUN(INPUT_LEFT, 3), DEMO_RUN(INPUT_SHOOT, 12), DEMO_RUN(INPUT_RIGHT, 32),
+	DEMO_RUN(INPUT_RIGHT, 26), DEMO_RUN(INPUT_SHOOT, 6), DEMO_RUN(INPUT_SHOOT, 11),
+	DEMO_RUN(INPUT_LEFT, 7), DEMO_RUN(INPUT_SHOOT, 12), DEMO_RUN(INPUT_LEFT, 30),
+	DEMO_RUN(INPUT_SHOOT, 9), DEMO_RUN(INPUT_SHOOT, 13), DEMO_RUN(INPUT_RIGHT, 11),
+	DEMO_RUN(INPUT_SHOOT, 5), DEMO_RUN(INPUT_RIGHT, 2), DEMO_RUN(INPUT_SHOOT, 14),
+	DEMO_RUN(INPUT_SHOOT, 5), DEMO_RUN(INPUT_SHOOT, 4), DEMO_RUN(INPUT_LEFT, 14),
+	DEMO_RUN(INPUT_SHOOT, 13), DEMO_RUN(INPUT_SHOOT, 14), DEMO_RUN(INPUT_SHOOT, 11),
+	DEMO_RUN(0, 16), DEMO_RUN(INPUT_RIGHT, 30), DEMO_RUN(INPUT_SHOOT, 4),
+	DEMO_RUN(INPUT_SHOOT, 11), DEMO_RUN(INPUT_LEFT, 4), DEMO_RUN(INPUT_SHOOT, 11),
+	DEMO_RUN(0, 13), DEMO_RUN(INPUT_LEFT, 32), DEMO_RUN(INPUT_LEFT, 9),
+	DEMO_RUN(INPUT_SHOOT, 7), DEMO_RUN(INPUT_SHOOT, 10), DEMO_RUN(INPUT_SHOOT, 10),
+	DEMO_RUN(INPUT_RIGHT, 31), DEMO_RUN(INPUT_SHOOT, 6), DEMO_RUN(INPUT_RIGHT, 4),
+	DEMO_RUN(INPUT_SHOOT, 6), DEMO_RUN(INPUT_SHOOT, 10), DEMO_RUN(INPUT_LEFT, 22),
+	DEMO_RUN(INPUT_SHOOT, 10), DEMO_RUN(INPUT_SHOOT, 9), DEMO_RUN(INPUT_SHOOT, 14),
+	DEMO_RUN(INPUT_LEFT, 4), DEMO_RUN(INPUT_SHOOT, 5), DEMO_RUN(0, 11),
+	DEMO_RUN(INPUT_RIGHT, 32), DEMO_RUN(INPUT_RIGHT, 3), DEMO_RUN(INPUT_SHOOT, 4),
+	DEMO_RUN(INPUT_LEFT, 5), DEMO_RUN(INPUT_SHOOT, 8), DEMO_RUN(0, 8),
+	DEMO_RUN(INPUT_LEFT, 14), DEMO_RUN(INPUT_SHOOT, 9), DEMO_RUN(INPUT_SHOOT, 13),
+	DEMO_RUN(INPUT_SHOOT, 13), DEMO_RUN(INPUT_LEFT, 25), DEMO_RUN(INPUT_SHOOT, 12),
+	DEMO_RUN(INPUT_SHOOT, 13), DEMO_RUN(INPUT_SHOOT, 14), DEMO_RUN(INPUT_LEFT, 7),
+	DEMO_RUN(INPUT_SHOOT, 14), DEMO_RUN(INPUT_SHOOT, 12), DEMO_RUN(INPUT_RIGHT, 29),
+	DEMO_RUN(INPUT_SHOOT, 5), DEMO_RUN(INPUT_SHOOT, 11), DEMO_RUN(INPUT_LEFT, 28),
+	DEMO_RUN(INPUT_SHOOT, 5), DEMO_RUN(INPUT_RIGHT, 32), DEMO_RUN(INPUT_SHOOT, 5),
+	DEMO_RUN(INPUT_LEFT, 32), DEMO_RUN(INPUT_LEFT, 1), DEMO_RUN(INPUT_SHOOT, 4),
+	DEMO_RUN(INPUT_RIGHT, 32), DEMO_RUN(INPUT_RIGHT, 9), DEMO_RUN(INPUT_SHOOT, 9)
+};
+
+#define DEMO_END (demo_script + sizeof(demo_script) / sizeof(demo_script[0]))
+
+struct demo_t demo;
+
+// ---------------------------------------------------------------------------
+// rewind the script and fix the random seed, call after the game state is
+// initialized
+
+void start_demo()
+{
+	demo.seed[0] = Vec_Random_Seed;
+	demo.seed[1] = *(&Vec_Random_Seed + 1);
+	demo.seed[2] = *(&Vec_Random_Seed + 2);
+	Vec_Random_Seed = DEMO_SEED_0;
+	*(&Vec_Random_Seed + 1) = DEMO_SEED_1;
+	*(&Vec_Random_Seed + 2) = DEMO_SEED_2;
+	
+	demo.next = demo_script;
+	demo.left = 0;
+}
+
+// ---------------------------------------------------------------------------
+// set the input of player 1 for this tick, returns 0 at the end of the
+// script
+
+int demo_input()
+{
+	if (!demo.left)
+	{
+		if (demo.next == DEMO_END)
+		{
+			return 0;
+		}
+		demo.input = *demo.next & 7;
+		demo.left = (unsigned int) ((*demo.next >> 3) + 1);
+		++demo.next;
+	}
+	else
+	{
+		demo.input &= (unsigned int) ~INPUT_SHOOT;
+	}
+	--demo.left;
+	input_1 = demo.input;
+	input_2 = 0;
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+// give the game its own random seed back, the demo leaves the sequence of
+// beans of the next game as it was
+
+void stop_demo()
+{
+	if (demo.next)
+	{
+		Vec_Random_Seed = demo.seed[0];
+		*(&Vec_Random_Seed + 1) = demo.seed[1];
+		*(&Vec_Random_Seed + 2) = demo.seed[2];
+		demo.next = 0;
+	}
+}
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -0,0 +1,38 @@
+// ***************************************************************************
+// demo
+// ***************************************************************************
+
+#pragma once
+
+// ---------------------------------------------------------------------------
+// input script of the attract mode
+//
+// the script is a rom table of runs, one byte each: bits 0-2 are the
+// INPUT_* bits of player 1, bits 3-7 the ticks of the run minus 1; a shot
+// is pressed in the first tick of its run only; with the random seed fixed
+// by start_demo() the game plays the same way every time, decoding costs
+// the same few instructions in every tick
+
+#define DEMO_RUN(input, ticks) ((unsigned int) ((((ticks) - 1) << 3) | (input)))
+
+#define DEMO_SEED_0	0x5A
+#define DEMO_SEED_1	0x3C
+#define DEMO_SEED_2	0x96
+
+struct demo_t
+{
+	const unsigned int* next;	// run after the current one, 0 = not running
+	unsigned int left;			// ticks left of the current run
+	unsigned int input;			// input of the current run
+	unsigned int seed[3];		// random seed of the game, restored by stop_demo()
+};
+
+extern struct demo_t demo;
+
+void start_demo();
+int demo_input();
+void stop_demo();
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
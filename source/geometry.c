@@ -0,0 +1,24 @@
+// ***************************************************************************
+// geometry
+// ***************************************************************************
+
+#include <vectrex.h>
+
+#include "geometry.h"
+
+// ---------------------------------------------------------------------------
+// generated from LANES and LANE_WIDTH, see geometry.h
+
+const int lane_borders[LANES_MAX + 1] = { GEOMETRY_32(LANE_BORDER), 121 };
+
+const int lane_centres[LANES_MAX] = { GEOMETRY_32(LANE_CENTRE) };
+
+const unsigned int lane_at_x[64] = { GEOMETRY_64(LANE_AT) };
+
+const unsigned int spawn_lanes[LANES_MAX] = { GEOMETRY_32(SPAWN_LANE) };
+
+const unsigned int ground_full[4] = { GROUND_FULL(0), GROUND_FULL(1), GROUND_FULL(2), GROUND_FULL(3) };
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
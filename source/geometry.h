@@ -0,0 +1,100 @@
+// ***************************************************************************
+// geometry
+// ***************************************************************************
+
+#pragma once
+#include "config.h"
+
+// ---------------------------------------------------------------------------
+// playfield: LANES tiles (config.h) of LANE_WIDTH in screen coordinates at
+// scale 110, centred on the screen; with more than 16 lanes they are half
+// as wide and pyoro stands on two of them
+//
+// all tables below are generated from these numbers by the preprocessor,
+// they have room for 32 lanes and the entries past LANES are not used
+//
+// a LANES=30 build draws one short vector per tile (draw_ground()), which
+// is cheaper than the 16 bios lines of the original floor; compare the
+// worst case of draw_ground, restore_tiles and game_frame of both builds
+// in tools\wcet.py --functions
+
+#ifndef LANE_WIDTH
+#define LANE_WIDTH (LANES <= 16 ? 16 : 8)
+#endif
+
+#ifndef PYORO_LANES
+#define PYORO_LANES (LANES <= 16 ? 1 : 2)	// lanes under one pyoro
+#endif
+
+#define LANE_LEFT ((int) (-(long int) LANES * LANE_WIDTH / 2))	// left end of lane 0
+#define LANES_MAX 32
+
+#if LANES > LANES_MAX || LANES * LANE_WIDTH > 256 || LANE_WIDTH % 4
+#error "lanes must fit the screen and be a multiple of 4 wide"
+#endif
+
+// random lane: Random() & (SPAWN_LANES - 1) indexes spawn_lanes[]
+#define SPAWN_LANES (LANES <= 16 ? 16 : 32)
+
+// floor bit mask, bytes of 8 tiles
+#define GROUND_BYTES ((LANES + 7) / 8)
+
+// ---------------------------------------------------------------------------
+// table generators, F(n) is the entry n of a table
+
+#define GEOMETRY_32(F) \
+	F(0), F(1), F(2), F(3), F(4), F(5), F(6), F(7), \
+	F(8), F(9), F(10), F(11), F(12), F(13), F(14), F(15), \
+	F(16), F(17), F(18), F(19), F(20), F(21), F(22), F(23), \
+	F(24), F(25), F(26), F(27), F(28), F(29), F(30), F(31)
+
+#define GEOMETRY_64(F) \
+	F(0), F(1), F(2), F(3), F(4), F(5), F(6), F(7), \
+	F(8), F(9), F(10), F(11), F(12), F(13), F(14), F(15), \
+	F(16), F(17), F(18), F(19), F(20), F(21), F(22), F(23), \
+	F(24), F(25), F(26), F(27), F(28), F(29), F(30), F(31), \
+	F(32), F(33), F(34), F(35), F(36), F(37), F(38), F(39), \
+	F(40), F(41), F(42), F(43), F(44), F(45), F(46), F(47), \
+	F(48), F(49), F(50), F(51), F(52), F(53), F(54), F(55), \
+	F(56), F(57), F(58), F(59), F(60), F(61), F(62), F(63)
+
+// (long arithmetic, int has 8 bits)
+
+// left border of lane n, lane 0 starts at the left wall (-120) and the
+// border after the last lane is the right wall + 1
+#define LANE_BORDER(n) ((n) == 0 ? -120 : (n) >= LANES ? 121 \
+	: (int) (LANE_LEFT + (long int) (n) * LANE_WIDTH))
+
+// x of a bean falling in lane n
+#define LANE_CENTRE(n) ((n) < LANES \
+	? (int) (LANE_LEFT + (long int) (n) * LANE_WIDTH + LANE_WIDTH / 2) : 0)
+
+// lane of the x coordinates -128 + 4 * n to -125 + 4 * n
+#define LANE_X(n) (-128L + 4L * (n) - LANE_LEFT)
+#define LANE_AT(n) (LANE_X(n) < 0 ? 0 \
+	: LANE_X(n) / LANE_WIDTH >= LANES ? LANES - 1 : (unsigned int) (LANE_X(n) / LANE_WIDTH))
+
+// lane of the random number n, spread evenly
+#define SPAWN_LANE(n) ((unsigned int) ((long int) (n) * LANES / SPAWN_LANES))
+
+// byte n of the intact floor
+#define GROUND_FULL(n) ((n) * 8 + 8 <= LANES ? 0xFF \
+	: (n) * 8 < LANES ? (1 << (LANES - (n) * 8)) - 1 : 0)
+
+extern const int lane_borders[LANES_MAX + 1];
+extern const int lane_centres[LANES_MAX];
+extern const unsigned int lane_at_x[64];
+extern const unsigned int spawn_lanes[LANES_MAX];
+extern const unsigned int ground_full[4];
+
+// ---------------------------------------------------------------------------
+
+static inline __attribute__((always_inline))
+unsigned int lane_at(int x)
+{
+	return lane_at_x[((unsigned int) x ^ 0x80) >> 2];
+}
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -7,71 +7,111 @@
 #include "types.h"
 
 #include "ground.h"
+#include "bean.h"
+#include "geometry.h"
+#include "utils/utils.h"
 
 // ---------------------------------------------------------------------------
-// global variable of the ground's state
-int ground_state[] = 
+// state of the ground, bit set = tile intact (tile 0 = left), see ground.h
+
+unsigned int ground_mask[GROUND_BYTES];
+
+// lit and blank tile, one vector at scale LANE_WIDTH
+const int vectors_tile[] = {-1, 0, 110, 1};
+const int vectors_gap[] = {0, 0, 110, 1};
+
+// ---------------------------------------------------------------------------
+// 1 if no tile is broken
+
+int ground_complete()
 {
-	1,
-	1,
-	1,
-	1,
-	1,
-	1,
-	1,
-	1,
-	1,
-	1,
-	1,
-	1,
-	1,
-	1,
-	1,
-	1
-	
-};
-// maybe something like packet type of johannsen
+	unsigned int i;
+	for (i = 0; i < GROUND_BYTES; ++i)
+	{
+		if (ground_mask[i] != ground_full[i])
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static inline __attribute__((always_inline))
+void repair_tile(unsigned int lane)
+{
+	ground_mask[lane >> 3] |= arith_bits[lane & 7];
+}
 
 // ---------------------------------------------------------------------------
 // function to set the ground's default values
 
 void init_ground()
 {
-	ground_state[0] = 1;
-	ground_state[1] = 1;
-	ground_state[2] = 1;
-	ground_state[3] = 1;
-	ground_state[4] = 1;
-	ground_state[5] = 1;
-	ground_state[6] = 1;
-	ground_state[7] = 1;
-	ground_state[8] = 1;
-	ground_state[9] = 1;
-	ground_state[10] = 1;
-	ground_state[11] = 1;
-	ground_state[12] = 1;
-	ground_state[13] = 1;
-	ground_state[14] = 1;
-	ground_state[15] = 1;
-	
+	unsigned int i;
+	for (i = 0; i < GROUND_BYTES; ++i)
+	{
+		ground_mask[i] = ground_full[i];
+	}
 }
 
+// ---------------------------------------------------------------------------
+// rebuild up to n broken tiles, nearest to lane first (left before right
+// at the same distance); at most LANES steps of two mask tests each, done
+// at once if nothing or everything has to be rebuilt
+
+void restore_tiles(unsigned int lane, unsigned int n)
+{
+	unsigned int d;
+	
+	if (n == 0 || ground_complete())
+	{
+		return;
+	}
+	if (n >= LANES)
+	{
+		init_ground();
+		return;
+	}
+	
+	for (d = 0; d < LANES; ++d)
+	{
+		if (lane >= d && !ground_tile(lane - d))
+		{
+			repair_tile(lane - d);
+			if (--n == 0 || ground_complete())
+			{
+				return;
+			}
+		}
+		if (lane + d < LANES && !ground_tile(lane + d))
+		{
+			repair_tile(lane + d);
+			if (--n == 0 || ground_complete())
+			{
+				return;
+			}
+		}
+	}
+}
 
 // ---------------------------------------------------------------------------
-// function to draw the ground in the screen
+// function to draw the ground in the screen, one vector per tile through
+// draw_vectors() instead of a bios line or move; a bean_slice() runs while
+// the beam moves to the left end
 
 void draw_ground()
 {
-	int x = 0;
+	unsigned int lane;
 	
-	Reset0Ref();
-	VIA_t1_cnt_lo = 110;
-	Moveto_d(-120, -128);
-	VIA_t1_cnt_lo = 16;
+	beam_reset();
+	beam_scale(110);
+	beam_move_begin(-120, LANE_LEFT);
+	bean_slice();
+	beam_move_end();
+	beam_scale(LANE_WIDTH);
 	
-	for(x = 0; x < 16; ++x)	//unroll later
+	for (lane = 0; lane < LANES; ++lane)
 	{
-		ground_state[x] ? Draw_Line_d(0,110) : Moveto_d(0,110);
+		beam_vectors(ground_tile(lane) ? vectors_tile : vectors_gap, 1);
 	}
-
 }
@@ -4,12 +4,31 @@
 
 #pragma once
 //#include "types.h"
+#include "geometry.h"
+#include "utils/arith.h"
 
 // ---------------------------------------------------------------------------
 
-extern int ground_state[];
+// ground as a bit mask, bit n & 7 of byte n >> 3 = tile n intact; the
+// bit of a tile comes from the power table of utils/arith.h, gcc6809
+// cannot shift by a variable count
+
+extern unsigned int ground_mask[GROUND_BYTES];
+
+static inline __attribute__((always_inline))
+unsigned int ground_tile(unsigned int lane)
+{
+	return ground_mask[lane >> 3] & arith_bits[lane & 7];
+}
+
+static inline __attribute__((always_inline))
+void break_tile(unsigned int lane)
+{
+	ground_mask[lane >> 3] &= (unsigned int) ~arith_bits[lane & 7];
+}
 
 void init_ground();
+void restore_tiles(unsigned int lane, unsigned int n);
 //void move_bean();
 void draw_ground();
 /*int*/ //void check_bean();
@@ -0,0 +1,86 @@
+// ***************************************************************************
+// hud
+// ***************************************************************************
+
+#include <vectrex.h>
+
+#include "utils/controller.h"
+#include "utils/perf.h"
+#include "utils/utils.h"
+#include "utils/digits.h"
+
+#include "hud.h"
+#include "bean.h"
+
+#if DEBUG
+
+#define HUD_Y 95	// below the score
+
+int hud_visible = 0;
+
+// ---------------------------------------------------------------------------
+// a byte as 3 packed bcd digits for draw_bcd(), hundreds in the low nibble
+// of the first byte, the high nibble stays 0
+
+static inline __attribute__((always_inline))
+void hud_bcd(unsigned int* bcd, unsigned int value)
+{
+	unsigned int tens = div10(value);
+	bcd[0] = div10(tens);
+	bcd[1] = (unsigned int) ((mod10(tens) << 4) | mod10(value));
+}
+
+// ---------------------------------------------------------------------------
+// number of beans on screen
+
+static inline __attribute__((always_inline))
+unsigned int beans_alive(void)
+{
+	unsigned int i;
+	unsigned int alive = 0;
+	for (i = 0; i < BEAN_COUNT; ++i)
+	{
+		if (beans_live & bean_bits[i])
+		{
+			++alive;
+		}
+	}
+	return alive;
+}
+
+// ---------------------------------------------------------------------------
+// toggle the overlay with button 3 of controller 1, call after read_input()
+
+void update_hud()
+{
+	if (button_1_3_pressed())
+	{
+		hud_visible = !hud_visible;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// draw the overlay with the vector digits (utils/digits.h), one draw_bcd()
+// per value
+
+void draw_hud()
+{
+	unsigned int bcd[2];
+	if (hud_visible)
+	{
+		hud_bcd(bcd, perf.remaining);
+		draw_bcd(HUD_Y, -120, bcd, 2);
+		hud_bcd(bcd, perf.worst);
+		draw_bcd(HUD_Y, -80, bcd, 2);
+		hud_bcd(bcd, perf.overruns);
+		draw_bcd(HUD_Y, -40, bcd, 2);
+		bcd[0] = beans_alive();
+		draw_bcd(HUD_Y, 0, bcd, 1);
+	}
+}
+
+#endif
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -0,0 +1,37 @@
+// ***************************************************************************
+// hud
+// ***************************************************************************
+
+#pragma once
+#include "config.h"
+
+// ---------------------------------------------------------------------------
+// frame budget overlay, only compiled with DEBUG=1, toggled with button 3
+// of controller 1; four decimal numbers in vector digits, left to right
+// - cycles / 256 left in the last frame
+// - cycles / 256 left in the worst frame of the last second
+// - number of overrun frames
+// - number of active beans
+
+#if DEBUG
+
+void update_hud();
+void draw_hud();
+
+#else
+
+static inline __attribute__((always_inline))
+void update_hud()
+{
+}
+
+static inline __attribute__((always_inline))
+void draw_hud()
+{
+}
+
+#endif
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -0,0 +1,79 @@
+// ***************************************************************************
+// input
+// ***************************************************************************
+
+#include <vectrex.h>
+
+#include "utils/controller.h"
+#include "utils/trace.h"
+
+#include "input.h"
+
+// ---------------------------------------------------------------------------
+// input of player 1 and 2 in the current frame
+
+unsigned int input_1 = 0;
+unsigned int input_2 = 0;
+
+// ---------------------------------------------------------------------------
+// sample joysticks and buttons, call once per frame right before the code
+// that reacts to the input and draws the result, so a press is on screen
+// in the same frame it was read; one Joy_Digital() reads every enabled
+// joystick and one Read_Btns() all eight buttons
+
+void read_input()
+{
+	check_joysticks();
+	check_buttons();	// every frame, otherwise presses while walking are lost
+	
+	input_1 &= INPUT_EDGES;
+	if (joystick_1_left())
+	{
+		input_1 |= INPUT_LEFT;
+	}
+	else if (joystick_1_right())
+	{
+		input_1 |= INPUT_RIGHT;
+	}
+	if (button_1_4_pressed())
+	{
+		input_1 |= INPUT_SHOOT;
+	}
+	if (button_1_1_pressed())
+	{
+		input_1 |= INPUT_START;
+	}
+	
+	input_2 &= INPUT_EDGES;
+	if (joystick_2_left())
+	{
+		input_2 |= INPUT_LEFT;
+	}
+	else if (joystick_2_right())
+	{
+		input_2 |= INPUT_RIGHT;
+	}
+	if (button_2_4_pressed())
+	{
+		input_2 |= INPUT_SHOOT;
+	}
+	if (button_2_1_pressed())
+	{
+		input_2 |= INPUT_START;
+	}
+	
+	trace_record(TRACE_INPUT, (int) input_1, (int) input_2);
+}
+
+// ---------------------------------------------------------------------------
+// drop the presses, call after every game logic tick
+
+void consume_input()
+{
+	input_1 &= (unsigned int) ~INPUT_EDGES;
+	input_2 &= (unsigned int) ~INPUT_EDGES;
+}
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
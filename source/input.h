@@ -0,0 +1,29 @@
+// ***************************************************************************
+// input
+// ***************************************************************************
+
+#pragma once
+
+// ---------------------------------------------------------------------------
+// input of one player for one frame, both controllers are sampled
+// together once per frame by read_input(); game code only looks at these
+// bits, never at the controller directly
+
+#define INPUT_LEFT	0b00000001	// joystick left
+#define INPUT_RIGHT	0b00000010	// joystick right
+#define INPUT_SHOOT	0b00000100	// button 4 pressed this frame
+#define INPUT_START	0b00001000	// button 1 pressed this frame, start / pause
+
+// presses are kept until a game logic tick consumed them, frames without a
+// tick (see utils/pace.h) must not lose them
+#define INPUT_EDGES	(INPUT_SHOOT | INPUT_START)
+
+extern unsigned int input_1;
+extern unsigned int input_2;
+
+void read_input();
+void consume_input();
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -0,0 +1,188 @@
+// ***************************************************************************
+// killcam
+// ***************************************************************************
+
+#include <vectrex.h>
+
+#include "killcam.h"
+#include "input.h"
+#include "pyoro.h"
+#include "bean.h"
+#include "ground.h"
+#include "particle.h"
+
+// ---------------------------------------------------------------------------
+// everything the game logic reads from one tick to the next, copied byte
+// by byte into and out of a snapshot; the particles are only drawn
+
+struct killcam_region_t
+{
+	unsigned int* data;
+	unsigned int size;
+};
+
+#define KILLCAM_REGIONS 9
+
+const struct killcam_region_t killcam_regions[KILLCAM_REGIONS] =
+{
+	{ (unsigned int*) pyoro,			sizeof(pyoro)		},
+	{ (unsigned int*) beans,			sizeof(beans)		},
+	{ (unsigned int*) &beans_live,		sizeof(beans_live)	},
+	{ (unsigned int*) &bean_timer,		sizeof(bean_timer)	},
+	{ (unsigned int*) &beans_ahead,		sizeof(beans_ahead)	},
+	{ (unsigned int*) &bean_plan,		sizeof(bean_plan)	},
+	{ ground_mask,						sizeof(ground_mask)	},
+	{ (unsigned int*) &score,			sizeof(score)		},
+	{ (unsigned int*) &Vec_Random_Seed,	3					},
+};
+
+struct killcam_t killcam;
+
+// ---------------------------------------------------------------------------
+
+void killcam_save(unsigned int* state)
+{
+	unsigned int i;
+	for (i = 0; i < KILLCAM_REGIONS; ++i)
+	{
+		const unsigned int* data = killcam_regions[i].data;
+		unsigned int n = killcam_regions[i].size;
+		do
+		{
+			*state++ = *data++;
+		}
+		while (--n);
+	}
+}
+
+void killcam_load(const unsigned int* state)
+{
+	unsigned int i;
+	for (i = 0; i < KILLCAM_REGIONS; ++i)
+	{
+		unsigned int* data = killcam_regions[i].data;
+		unsigned int n = killcam_regions[i].size;
+		do
+		{
+			*data++ = *state++;
+		}
+		while (--n);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// start a new segment with a snapshot of the current state, the older
+// segment is dropped
+
+void killcam_segment()
+{
+	struct killcam_segment_t* s;
+	killcam.current ^= 1;
+	s = &killcam.segment[killcam.current];
+	killcam_save(s->state);
+	s->used = 0;
+	s->ticks = 0;
+}
+
+// ---------------------------------------------------------------------------
+// call at the start of a game, after the game state is initialized
+
+void init_killcam()
+{
+	killcam.segment[1].ticks = 0;
+	killcam.current = 1;
+	killcam_segment();		// segment 0, segment 1 stays empty
+	killcam.replay = KILLCAM_IDLE;
+}
+
+// ---------------------------------------------------------------------------
+// log the input of this tick, call before the game logic of the tick runs
+
+void record_killcam()
+{
+	struct killcam_segment_t* s = &killcam.segment[killcam.current];
+	unsigned int input = (unsigned int) (input_1 | (input_2 << 4));
+	
+	if (s->ticks == KILLCAM_PERIOD)
+	{
+		killcam_segment();
+		s = &killcam.segment[killcam.current];
+	}
+	++s->ticks;
+	
+	if (s->used && s->runs[s->used - 1][0] == input)
+	{
+		++s->runs[s->used - 1][1];
+		return;
+	}
+	if (s->used == KILLCAM_RUNS)
+	{
+		// log full, the tick is logged in a new segment; the snapshot is
+		// taken before the tick, so the older segment stays complete
+		--s->ticks;
+		killcam_segment();
+		s = &killcam.segment[killcam.current];
+		++s->ticks;
+	}
+	s->runs[s->used][0] = input;
+	s->runs[s->used][1] = 1;
+	++s->used;
+}
+
+// ---------------------------------------------------------------------------
+// restore the state at the start of the older segment and replay from
+// there, call once after the game ended
+
+void start_killcam()
+{
+	unsigned int older = killcam.current ^ 1;
+	if (!killcam.segment[older].ticks)
+	{
+		older = killcam.current;	// game shorter than one segment
+	}
+	killcam.replay = older;
+	killcam.run = 0;
+	killcam.left = killcam.segment[older].runs[0][1];
+	killcam_load(killcam.segment[older].state);
+	init_particles();
+}
+
+// ---------------------------------------------------------------------------
+// set the input of the next replayed tick, returns 0 at the end of the
+// replay, the game state is then the one the game ended with
+
+int replay_killcam()
+{
+	const struct killcam_segment_t* s;
+	
+	if (!killcam_replaying())
+	{
+		return 0;
+	}
+	s = &killcam.segment[killcam.replay];
+	if (!killcam.left)
+	{
+		if (++killcam.run == s->used)
+		{
+			if (killcam.replay == killcam.current)
+			{
+				killcam.replay = KILLCAM_IDLE;
+				return 0;
+			}
+			// continue with the newer segment, its snapshot is the state
+			// the replay has reached
+			killcam.replay = killcam.current;
+			killcam.run = 0;
+			s = &killcam.segment[killcam.replay];
+		}
+		killcam.left = s->runs[killcam.run][1];
+	}
+	--killcam.left;
+	input_1 = s->runs[killcam.run][0] & 15;
+	input_2 = s->runs[killcam.run][0] >> 4;
+	return 1;
+}
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -0,0 +1,78 @@
+// ***************************************************************************
+// killcam
+// ***************************************************************************
+
+#pragma once
+
+#include "pyoro.h"
+#include "bean.h"
+#include "geometry.h"
+
+// ---------------------------------------------------------------------------
+// replay of the last seconds before the game ended
+//
+// the game logic is deterministic given its state, the input of every tick
+// and the bios random seed, so instead of recording what happened only the
+// input is logged; a snapshot of the game state is taken every
+// KILLCAM_PERIOD ticks (or when the log is full) and the last two segments
+// of snapshot plus run length coded input are kept, the replay restarts
+// from the older snapshot and feeds the logged input to the game logic
+//
+// recording is one compare and one increment per tick while the input
+// does not change; a new segment copies the snapshot (about 400 cycles
+// every KILLCAM_PERIOD ticks)
+//
+// ram: two segments of snapshot (49 bytes), KILLCAM_RUNS runs (32 bytes)
+// and 2 counters, plus 4 bytes of replay state, 170 bytes; the snapshot
+// alone is more than the few dozen bytes once planned, and a single
+// segment would make the replay anything from 0 to KILLCAM_PERIOD ticks
+// long, a death right after a new snapshot would replay nothing
+
+#define KILLCAM_PERIOD	128	// ticks per segment, the replay is 1 to 2 of them
+#define KILLCAM_RUNS	16	// input runs per segment
+
+// pyoros, beans, live beans, bean timer, beans moved ahead and the planned
+// spawn (bean.h), ground, score and the 3 byte random seed, 49 bytes (51
+// with 30 lanes)
+#define KILLCAM_STATE	(sizeof(struct player) * PLAYERS \
+	+ sizeof(struct object) * BEAN_COUNT \
+	+ 3 * sizeof(unsigned int) + sizeof(struct bean_plan_t) \
+	+ GROUND_BYTES + sizeof(unsigned long int) + 3)
+
+struct killcam_segment_t
+{
+	unsigned int state[KILLCAM_STATE];		// game state at the start
+	unsigned int runs[KILLCAM_RUNS][2];		// input (player 2 high nibble), ticks
+	unsigned int used;						// runs in use
+	unsigned int ticks;						// ticks recorded
+};
+
+struct killcam_t
+{
+	struct killcam_segment_t segment[2];
+	unsigned int current;	// segment recorded into, the other one is older
+	unsigned int replay;	// segment replayed, 2 = not replaying
+	unsigned int run;		// run replayed
+	unsigned int left;		// ticks left of that run
+};
+
+extern struct killcam_t killcam;
+
+#define KILLCAM_IDLE 2
+
+// ---------------------------------------------------------------------------
+
+static inline __attribute__((always_inline))
+int killcam_replaying(void)
+{
+	return killcam.replay != KILLCAM_IDLE;
+}
+
+void init_killcam();
+void record_killcam();
+void start_killcam();
+int replay_killcam();
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
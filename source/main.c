@@ -6,10 +6,22 @@
 
 #include "utils/controller.h"
 #include "utils/print.h"
+#include "utils/digits.h"
+#include "utils/trace.h"
+#include "utils/utils.h"
+#include "utils/perf.h"
+#include "utils/task.h"
+#include "utils/pace.h"
 
+#include "input.h"
 #include "pyoro.h"
 #include "bean.h"
 #include "ground.h"
+#include "hud.h"
+#include "particle.h"
+#include "killcam.h"
+#include "demo.h"
+#include "retain.h"
 
 // Notes
 // Original pyoro walks on 1 or 2 tiles at the same time
@@ -23,128 +35,423 @@
 // if the reset button is pressed, then a warm reset is performed
 // warm reset: skip vectrex logo and keep ram data
 // after each reset, the game title screen is shown and then main() is called
+// statics are initialized again after every reset, only the block in
+// retain.h survives a warm reset; build with FAST_BOOT=1 to shorten the
+// bios title screen (cartridge.c) and to skip the game's title sequence
+// after a warm reset
 
 // start of program code
 
 //int i;
 
+// number of players of the next game, 2 = co-op
+unsigned int game_players = 1;
+
 void game_init()
 {
-	// activate first joystick, switch off second joystick
+	// activate first joystick, second joystick only in a two player game,
+	// Joy_Digital() reads both in one call then
 	enable_controller_1_x();
 	enable_controller_1_y();
-	disable_controller_2_x();
-	disable_controller_2_y();
+	if (game_players == 2)
+	{
+		enable_controller_2_x();
+		enable_controller_2_y();
+	}
+	else
+	{
+		disable_controller_2_x();
+		disable_controller_2_y();
+	}
 	
-	init_pyoro();
-	spawn_bean();
+	init_pyoro(game_players);
+	init_beans();
 	init_ground();
-	
+	init_particles();
+	init_killcam();
+}
+
+// ---------------------------------------------------------------------------
+// game states, every state has an update and a draw function which are
+// called once per frame by game_frame(), enter is called once when the
+// state is switched to (may be 0)
+
+#define STATE_TITLE		0
+#define STATE_PLAY		1
+#define STATE_PAUSE		2
+#define STATE_GAME_OVER	3
+#define STATE_ATTRACT	4
+
+struct state_t
+{
+	void (*enter)(void);
+	void (*update)(void);
+	void (*draw)(void);
+};
+
+extern const struct state_t states[];
+extern const struct task_entry_t tasks[];
+
+#define TASKS 3
+
+unsigned int game_state = STATE_TITLE;
+
+// a new state stops the sequences of the old one
+void set_state(unsigned int next)
+{
+	game_state = next;
+	stop_tasks(tasks, TASKS);
+	if (states[next].enter)
+	{
+		states[next].enter();
+	}
 }
 
 // ---------------------------------------------------------------------------
-// main game loop, this is where the action happens
+// title: hi-score and start prompt, attract mode after 5 seconds; a
+// button on controller 2 starts a two player game
+
+struct task_t title_task;
 
-void game_loop()
+void title_sequence(struct task_t* t)
 {
-	int player_alive = 1;
+	TASK_BEGIN(t);
+	TASK_WAIT(t, 250);
+	game_players = 1;
+	set_state(STATE_ATTRACT);
+	TASK_END(t);
+}
+
+void title_enter()
+{
+	stop_demo();
+	task_start(&title_task);
+}
+
+void title_update()
+{
+	if (input_2 & (INPUT_START | INPUT_SHOOT))
+	{
+		game_players = 2;
+		game_init();
+		set_state(STATE_PLAY);
+	}
+	else if (input_1 & (INPUT_START | INPUT_SHOOT))
+	{
+		game_players = 1;
+		game_init();
+		set_state(STATE_PLAY);
+	}
+}
+
+void title_draw()
+{
+	print_str(40, -35, "PYORO");
+	print_str(0, -70, "HI");
+	draw_number(0, -10, retain.hiscore);
+	print_str(-40, -70, "PRESS BUTTON");
+	print_str(-60, -70, "PAD 2: 2 PLAYERS");
+}
+
+// ---------------------------------------------------------------------------
+// play: the actual game; when the last pyoro dies the death sequence lets
+// the fragments fly before the game is over
+
+struct task_t death_task;
+
+void death_sequence(struct task_t* t)
+{
+	unsigned int n;
 	
-	// as long as player is alive
-	while(player_alive)
+	TASK_BEGIN(t);
+	for (n = 0; n < players; ++n)
 	{
-		Wait_Recal();
-		Intensity_5F();
-		
-		// move pyoro
-		move_pyoro();
-		
-		if(bean.drawn)
-		{	
-			// move bean
-			move_bean();
-			
-			// check ground collision
-			check_bean();
-			
-			// draw bean
-			draw_bean();
-		}
-		else
-		{
-			spawn_bean();
-		}
-		
-		
-		// draw pyoro
-		draw_pyoro();
-		
-		// draw the ground
-		draw_ground();
-		
-		//-----------------------------------------
-		// Developer help lines and dots
-		
-		// Draw bean lines
-		/*Reset0Ref();
-		VIA_t1_cnt_lo = 110;
-		Moveto_d(0,-120);
-		for (i = 0; i < 16; i++)
-		{
-			Draw_Line_d(-120,0);
-			Moveto_d(120,16);
-		}*/
-		
-		// draw(0|0) dot
-		/*Reset0Ref();
-		VIA_t1_cnt_lo = 110;
-		Moveto_d(0, 0);
-		Dot_here();*/
-		
-		// draw bottom line
-		/*Reset0Ref();
-		VIA_t1_cnt_lo = 110;
-		Moveto_d(-120, -128);
-		Draw_Line_d(0,127);
-		Draw_Line_d(0,127);*/
-		
-		//-----------------------------------------
-		
-		// check for collisions
-		player_alive = check_pyoro();
+		burst_particles(pyoro[n].coord.y, pyoro[n].coord.x);
 	}
+	TASK_WAIT(t, 40);
+	set_state(game_state == STATE_ATTRACT ? STATE_TITLE : STATE_GAME_OVER);
+	TASK_END(t);
+}
+
+// one tick of game logic, returns the number of pyoros alive; everything
+// it changes but the particles is in the killcam snapshot (killcam.c)
+int play_tick()
+{
+	// move beans, check ground collision, spawn new ones
+	update_beans();
+	
+	// move pyoro
+	move_pyoro();
+	
+	// bean and tile fragments
+	update_particles();
+	
+	// check all beans against all players in one pass
+	return check_pyoro();
+}
+
+void play_update()
+{
+	if ((input_1 | input_2) & INPUT_START)
+	{
+		set_state(STATE_PAUSE);
+		return;
+	}
+	
+	// log the input up to the tick the game is lost
+	if (!task_running(&death_task))
+	{
+		record_killcam();
+	}
+	
+	if (!play_tick() && !task_running(&death_task))
+	{
+		task_start(&death_task);
+	}
+}
+
+void play_draw()
+{
+	// draw beans
+	draw_beans();
+	
+	// draw the ground
+	draw_ground();
+	
+	// draw pyoro
+	draw_pyoro();
+	
+	// draw fragments, limited to PARTICLE_BUDGET dots
+	draw_particles();
+	
+	// draw the score
+	draw_number(110, -20, score);
+	
+	//-----------------------------------------
+	// Developer help lines and dots
+	
+	// Draw bean lines
+	/*Reset0Ref();
+	VIA_t1_cnt_lo = 110;
+	Moveto_d(0,-120);
+	for (i = 0; i < 16; i++)
+	{
+		Draw_Line_d(-120,0);
+		Moveto_d(120,16);
+	}*/
+	
+	// draw(0|0) dot
+	/*Reset0Ref();
+	VIA_t1_cnt_lo = 110;
+	Moveto_d(0, 0);
+	Dot_here();*/
+	
+	// draw bottom line
+	/*Reset0Ref();
+	VIA_t1_cnt_lo = 110;
+	Moveto_d(-120, -128);
+	Draw_Line_d(0,127);
+	Draw_Line_d(0,127);*/
+	
+	//-----------------------------------------
 }
 
+// ---------------------------------------------------------------------------
+// pause: game frozen but still drawn
+
+void pause_update()
+{
+	if ((input_1 | input_2) & INPUT_START)
+	{
+		set_state(STATE_PLAY);
+	}
+}
 
+void pause_draw()
+{
+	play_draw();
+	print_str(40, -35, "PAUSE");
+}
 
 // ---------------------------------------------------------------------------
 // R.I.P.
+// replay the last seconds before the end (killcam.h), then show the good
+// bye message for 3 seconds, maybe more like original
+
+struct task_t game_over_task;
+
+void game_over_sequence(struct task_t* t)
+{
+	TASK_BEGIN(t);
+	
+	// keep hi-score and random seed over a warm reset, before the replay
+	// rewinds them
+	store_retain(score);
+	start_killcam();
+	
+	TASK_WAIT_UNTIL(t, !killcam_replaying());
+	TASK_WAIT(t, 150);
+	set_state(STATE_TITLE);
+	TASK_END(t);
+}
+
+void game_over_enter()
+{
+	task_start(&game_over_task);
+}
+
+void game_over_update()
+{
+	if (replay_killcam())
+	{
+		play_tick();
+	}
+}
+
+void game_over_draw()
+{
+	play_draw();
+	print_str(0, -70, "GAME OVER");
+}
+
+// ---------------------------------------------------------------------------
+// attract: the game plays itself from the script in demo.c until pyoro
+// dies, the script ends or a button is pressed
+
+void attract_enter()
+{
+	game_init();
+	start_demo();
+}
 
-void game_over()
+void attract_update()
 {
-	// show good bye message for 3 seconds
-	// maybe more like original
-	unsigned int t = 150;
-	while(--t > 0)
+	if (((input_1 | input_2) & (INPUT_START | INPUT_SHOOT)) || !demo_input())
 	{
-		Wait_Recal();
-		Reset0Ref();
-		print_str(0, -70, "GAME OVER");
+		set_state(STATE_TITLE);
+		return;
 	}
+	
+	play_update();
 }
 
+void attract_draw()
+{
+	play_draw();
+	print_str(100, -50, "DEMO");
+}
+
+// ---------------------------------------------------------------------------
+// indexed by STATE_*
+
+const struct state_t states[] =
+{
+	{ title_enter,		title_update,		title_draw		},
+	{ 0,				play_update,		play_draw		},
+	{ 0,				pause_update,		pause_draw		},
+	{ game_over_enter,	game_over_update,	game_over_draw	},
+	{ attract_enter,	attract_update,		attract_draw	},
+};
+
+// ---------------------------------------------------------------------------
+// sequences over several frames, resumed once per frame by game_frame()
+
+const struct task_entry_t tasks[TASKS] =
+{
+	{ &title_task,		title_sequence		},
+	{ &death_task,		death_sequence		},
+	{ &game_over_task,	game_over_sequence	},
+};
+
+// ---------------------------------------------------------------------------
+// one frame in any state, sound, input, profiling and the debug overlay
+// are handled here once for all states
+
+void game_frame()
+{
+	unsigned int ticks;
+	
+	Wait_Recal();
+	ticks = pace_ticks();
+	perf_frame_begin();
+	if (game_state == STATE_PLAY)
+	{
+		perf_boot();
+	}
+	
+	// audio tick, the effects of the last frame's events (utils/sound.h)
+	update_sound();
+	perf_phase(PERF_SOUND);
+	
+	trace_frame();
+	beam_frame();
+	beam_intensity_5F();
+	
+	// sample the controller right before the state reacts to it, the
+	// result is drawn in the same frame
+	read_input();
+	update_hud();
+	perf_phase(PERF_INPUT);
+	
+	// game logic runs in fixed ticks, 0 to 2 per frame depending on the
+	// refresh rate (utils/pace.h), drawing once per frame
+	while (ticks--)
+	{
+		states[game_state].update();
+		if (game_state != STATE_PAUSE)
+		{
+			run_tasks(tasks, TASKS);
+		}
+		consume_input();
+	}
+	perf_phase(PERF_UPDATE);
+	perf_set(players, players);
+	perf_set(refresh, pace.level);
+	perf_set(rate_changes, pace.changes);
+	
+	states[game_state].draw();
+	
+	// frame budget overlay (debug builds only), values of the last frame;
+	// drawn before the end mark so its cost and overruns are counted
+	draw_hud();
+	perf_phase(PERF_DRAW);
+	perf_frame_end();
+	
+	// adapt the refresh period to the load of this frame
+	pace_frame_end();
+}
+
+// ---------------------------------------------------------------------------
+
 int main(void)
 {	
 	// local variables
 	int error_code = 0;
 	
+	// restore what survived a warm reset; with FAST_BOOT=1 a warm reset
+	// restarts the game right away, without the title sequence
+	init_retain();
+	init_pace();
+	sound_init();
+	
+	// bios against own sprite drawing, debug builds only (utils/vectors.h)
+	bench_vectors(vectors_pyoro_right, PYORO_VECTORS, pyoro[0].scale, 0);
+	bench_vectors(bean_types[BEAN_NORMAL].sprite, bean_types[BEAN_NORMAL].vectors,
+		bean_types[BEAN_NORMAL].scale, 2);
+	if (FAST_BOOT && warm_boot)
+	{
+		game_init();
+		set_state(STATE_PLAY);
+	}
+	else
+	{
+		set_state(STATE_TITLE);
+	}
+	
 	// main loop
 	do
 	{
-		//game_options();
-		game_init();
-		game_loop();
-		game_over();
-		
+		game_frame();
 	}
 	while (1);
 	
@@ -0,0 +1,145 @@
+// ***************************************************************************
+// particle
+// ***************************************************************************
+
+#include <vectrex.h>
+
+#include "particle.h"
+#include "utils/utils.h"
+
+// ---------------------------------------------------------------------------
+// start velocities of the fragments of a burst (y, x)
+
+const int particle_burst[PARTICLE_BURST][2] =
+{
+	{ 4,  0},
+	{ 3,  3},
+	{ 3, -3},
+	{ 1,  4},
+	{ 1, -4},
+	{ 2,  1}
+};
+
+// ---------------------------------------------------------------------------
+
+struct particle_t particles[PARTICLE_COUNT];
+
+// first particle drawn in the next frame, rotates if over budget
+unsigned int particle_first = 0;
+
+// Dot_List() data of the current frame, relative moves at half resolution
+int particle_dots[PARTICLE_BUDGET][2];
+
+// ---------------------------------------------------------------------------
+// free all particles, call at the start of a game
+
+void init_particles()
+{
+	unsigned int i;
+	for (i = 0; i < PARTICLE_COUNT; ++i)
+	{
+		particles[i].life = 0;
+	}
+	particle_first = 0;
+}
+
+// ---------------------------------------------------------------------------
+// start a burst at absolute coordinates (y, x)
+
+void burst_particles(int y, int x)
+{
+	unsigned int i = 0;
+	unsigned int n;
+	for (n = 0; n < PARTICLE_BURST; ++n)
+	{
+		while (i < PARTICLE_COUNT && particles[i].life)
+		{
+			++i;
+		}
+		if (i == PARTICLE_COUNT)
+		{
+			return;	// pool full, drop the rest of the burst
+		}
+		particles[i].y = y;
+		particles[i].x = x;
+		particles[i].dy = particle_burst[n][0];
+		particles[i].dx = particle_burst[n][1];
+		particles[i].life = PARTICLE_LIFE;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// move and age all particles, with a bit of gravity
+
+void update_particles()
+{
+	unsigned int i;
+	for (i = 0; i < PARTICLE_COUNT; ++i)
+	{
+		struct particle_t* p = &particles[i];
+		if (p->life)
+		{
+			p->y += p->dy;
+			p->x += p->dx;
+			if ((p->life & 3) == 0)
+			{
+				--p->dy;
+			}
+			if (p->y < -120 || p->y > 120 || p->x < -120 || p->x > 120)
+			{
+				p->life = 0;	// left the screen
+			}
+			else
+			{
+				--p->life;
+			}
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// draw up to PARTICLE_BUDGET particles as one dot list; coordinates are
+// halved and drawn at twice the game scale so every relative move between
+// two dots fits into a byte
+
+void draw_particles()
+{
+	unsigned int count = 0;
+	unsigned int i = particle_first;
+	unsigned int n;
+	int y = 0;
+	int x = 0;
+	
+	for (n = 0; n < PARTICLE_COUNT && count < PARTICLE_BUDGET; ++n)
+	{
+		struct particle_t* p = &particles[i];
+		if (p->life)
+		{
+			particle_dots[count][0] = (p->y >> 1) - y;
+			particle_dots[count][1] = (p->x >> 1) - x;
+			y = p->y >> 1;
+			x = p->x >> 1;
+			++count;
+		}
+		if (++i == PARTICLE_COUNT)
+		{
+			i = 0;
+		}
+	}
+	
+	if (count == 0)
+	{
+		return;
+	}
+	
+	// over budget: start with the first one left out next frame
+	particle_first = (count == PARTICLE_BUDGET) ? i : 0;
+	
+	beam_reset();
+	beam_scale(220);
+	beam_dots(&particle_dots[0][0], count);
+}
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -0,0 +1,37 @@
+// ***************************************************************************
+// particle
+// ***************************************************************************
+
+#pragma once
+
+// ---------------------------------------------------------------------------
+// short lived dots bursting from caught beans and broken tiles
+//
+// all particles live in a fixed pool, a burst that finds the pool full
+// simply gets fewer fragments; at most PARTICLE_BUDGET dots are drawn per
+// frame in a single Dot_List() call, if more are alive the drawn subset
+// rotates from frame to frame so the effect flickers instead of costing
+// the game a frame
+
+#define PARTICLE_COUNT	12	// pool size
+#define PARTICLE_BURST	6	// fragments per burst
+#define PARTICLE_LIFE	16	// frames a fragment lives
+#define PARTICLE_BUDGET	8	// dots drawn per frame
+
+struct particle_t
+{
+	int y;
+	int x;
+	int dy;
+	int dx;
+	unsigned int life;	// frames left, 0 = free
+};
+
+void init_particles();
+void burst_particles(int y, int x);
+void update_particles();
+void draw_particles();
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -4,17 +4,20 @@
 
 #include <vectrex.h>
 
-#include "utils/controller.h"
+#include "utils/utils.h"
+#include "utils/perf.h"
 
+#include "input.h"
 #include "pyoro.h"
 #include "types.h"
 #include "bean.h"
 #include "ground.h"
+#include "geometry.h"
 
 // ---------------------------------------------------------------------------
 // constant data for pyoro's vectors
 
-const int vectors_pyoro_right[] =
+const int vectors_pyoro_right[PYORO_VECTORS * 3 + 1] =
 {
 	0,0,-50,
 	-1,-50,50,
@@ -26,7 +29,7 @@ const int vectors_pyoro_right[] =
 	1
 };
 
-const int vectors_pyoro_left[] =
+const int vectors_pyoro_left[PYORO_VECTORS * 3 + 1] =
 {
 	0,0,50,
 	-1,-50,-50,
@@ -38,29 +41,6 @@ const int vectors_pyoro_left[] =
 	1
 };
 
-// ---------------------------------------------------------------------------
-// look-up table of the left lane borders
-const int lane_borders[] = 
-{
-	-120,	//Lane 0	from -120 to -113
-	-112,	//Lane 1	from -112 to -97
-	-96,	//Lane 2	from -96  to -81
-	-80,	//Lane 3	from -80  to -65
-	-64,	//Lane 4	from -64  to -49
-	-48,	//Lane 5	from -48  to -33
-	-32,	//Lane 6	from -32  to -17
-	-16,	//Lane 7	from -16  to -1
-	0,		//Lane 8	from  0   to  15
-	16,		//Lane 9	from  16  to  31
-	32,		//Lane 10	from  32  to  47
-	48,		//Lane 12	from  48  to  63
-	64,		//Lane 13	from  64  to  79
-	80,		//Lane 14	from  80  to  95
-	96,		//Lane 15	from  96  to  111
-	112,	//Lane 16	from  112 to  120
-	121		//Most right border 120 + 1 due to way of internal calculation
-};
-
 // ---------------------------------------------------------------------------
 // distance variables initialization
 
@@ -68,60 +48,113 @@ int distance_x = 0;
 int distance_y = 0;
 
 // ---------------------------------------------------------------------------
-// global variable for pyoro's sprite
+// points of the current game, one per caught bean
 
-struct player pyoro =
+unsigned long int score = 0;
+
+// ---------------------------------------------------------------------------
+// global variable for the pyoros' sprites, pyoro[1] only plays in a two
+// player game
+
+struct player pyoro[PLAYERS] =
 {
 	{
-		{0, 0}	// coord.y, coord.x
-		
+		{
+			{0, 0}	// coord.y, coord.x
+			
+		},
+		8,		// lane
+		3,		// speed
+		RIGHT,	// direction
+		20,		// scale
+		0,		// shot_pending
+		0,		// shooting
+		0,		// tongue
+		0		// alive
+		// union mit : 1;
 	},
-	8,		// lane
-	3,		// speed
-	RIGHT,	// direction
-	20		// scale
-	// union mit : 1;
+	{
+		{
+			{0, 0}	// coord.y, coord.x
+			
+		},
+		10,		// lane
+		3,		// speed
+		LEFT,	// direction
+		20,		// scale
+		0,		// shot_pending
+		0,		// shooting
+		0,		// tongue
+		0		// alive
+	}
+};
+
+unsigned int players = 1;
+
+// ---------------------------------------------------------------------------
+// start lanes of one or two players
+
+const unsigned int start_lane[PLAYERS][PLAYERS] =
+{
+	{LANES / 2, LANES / 2},
+	{LANES / 2 - 2 * PYORO_LANES, LANES / 2 + 2 * PYORO_LANES}
 };
 
 // ---------------------------------------------------------------------------
-// function to set pyoro's default values
+// function to set pyoro's default values for a game of count players
 
-void init_pyoro()
+void init_pyoro(unsigned int count)
 {
-	pyoro.coord.y = -120;
-	pyoro.coord.x = 0;
-	pyoro.lane = 8;
-	pyoro.direction = RIGHT;
+	unsigned int n;
+	players = count;
+	for (n = 0; n < PLAYERS; ++n)
+	{
+		struct player* p = &pyoro[n];
+		p->lane = start_lane[count - 1][n];
+		p->coord.y = -120;
+		p->coord.x = lane_borders[p->lane];
+		p->direction = n ? LEFT : RIGHT;
+		p->shot_pending = 0;
+		p->shooting = 0;
+		p->tongue = 0;
+		p->alive = n < count;
+	}
+	score = 0;
 	
 }
 
 // ---------------------------------------------------------------------------
 // function to draw pyoro in the screen
 
-void draw_pyoro()
+void draw_player(struct player* p)
 {
-	Reset0Ref();
-	VIA_t1_cnt_lo = 110;
-	Moveto_d(pyoro.coord.y,pyoro.coord.x);
-	VIA_t1_cnt_lo = pyoro.scale;
+	beam_reset();
+	beam_scale(110);
+	beam_move_begin(p->coord.y,p->coord.x);
+	bean_slice();
+	beam_move_end();
+	beam_scale(p->scale);
 	
-	if(pyoro.direction)
+	if(p->direction)
 	{
-		Draw_VLp(&vectors_pyoro_right);
+		beam_vectors(vectors_pyoro_right, PYORO_VECTORS);
 	}
 	else
 	{
-		Draw_VLp(&vectors_pyoro_left);
+		beam_vectors(vectors_pyoro_left, PYORO_VECTORS);
 	}
 	
-	//play shooting animation
-	/*
-	Reset0Ref();
-	VIA_t1_cnt_lo = 110;
-	Moveto_d(pyoro.coord.y,pyoro.coord.x);
-	Draw_Line_d(127,pyoro.direction?127:-127);
-	Draw_Line_d(127,pyoro.direction?127:-127);
-	*/
+	// play shooting animation, once per shot however many ticks the frame
+	// ran (none at all when pace_ticks() returns 0)
+	if (p->tongue)
+	{
+		p->tongue = 0;
+		beam_reset();
+		beam_scale(110);
+		beam_moveto(p->coord.y,p->coord.x);
+		beam_line(127,p->direction?127:-127);
+		beam_line(127,p->direction?127:-127);
+	}
 	
 	// Developer help, draw line which resembles pyoro's current lane
 	/*
@@ -132,120 +165,170 @@ void draw_pyoro()
 	*/
 }
 
+void draw_pyoro()
+{
+	unsigned int n;
+	for (n = 0; n < players; ++n)
+	{
+		if (pyoro[n].alive)
+		{
+			draw_player(&pyoro[n]);
+		}
+	}
+}
+
 // ---------------------------------------------------------------------------
-// control pyoro with joystick 1
+// control one pyoro with the input of its player, see read_input()
 
 //no moving while walking
-void move_pyoro()	//maybe multiple different movement functions instead of using pyoro.speed
+void move_player(struct player* p, unsigned int input)	//maybe multiple different movement functions instead of using pyoro.speed
 {
-	// read joystick values
-	check_joysticks();
+	// a press is fired as soon as pyoro stands, or dropped after
+	// PYORO_SHOT_TICKS ticks of walking
+	if (input & INPUT_SHOOT)
+	{
+		p->shot_pending = PYORO_SHOT_TICKS;
+	}
+	else if (p->shot_pending)
+	{
+		--p->shot_pending;
+	}
 	
 	// only x movement
-	if (joystick_1_left() && pyoro.coord.x > -120)
+	if ((input & INPUT_LEFT) && p->coord.x > -120)
 	{
-		pyoro.coord.x -= pyoro.speed;	// move pyoro to the left
-		pyoro.direction = LEFT;			// set the direction pyoro faces
+		p->coord.x -= p->speed;	// move pyoro to the left
+		p->direction = LEFT;			// set the direction pyoro faces
 		
-		if(pyoro.coord.x < lane_borders[pyoro.lane])	// if pyoro walked onto another lane
+		if(lane_at(p->coord.x) < p->lane)	// if pyoro walked onto another lane
 		{
-			if(ground_state[pyoro.lane-1])	// 
+			if(ground_tile(p->lane-1))	// 
 			{
-				--pyoro.lane;
+				--p->lane;
 			}
 			else
 			{
-				pyoro.coord.x = lane_borders[pyoro.lane];
+				p->coord.x = lane_borders[p->lane];
 			}
 		}
 		
 	}
-	else if (joystick_1_right() && pyoro.coord.x < 120)
+	else if ((input & INPUT_RIGHT) && p->coord.x < 120)
 	{
-		pyoro.coord.x += pyoro.speed;
-		pyoro.direction = RIGHT;
+		p->coord.x += p->speed;
+		p->direction = RIGHT;
 		
-		if(pyoro.coord.x >= lane_borders[pyoro.lane+1])
+		if(lane_at(p->coord.x) > p->lane)
 		{
-			if(ground_state[pyoro.lane+1])
+			// the tile entering the footprint on the right
+			if(p->lane + PYORO_LANES < LANES && ground_tile(p->lane + PYORO_LANES))
 			{
-				++pyoro.lane;
+				++p->lane;
 			}
 			else
 			{
-				pyoro.coord.x = lane_borders[pyoro.lane+1]-1;
+				p->coord.x = lane_borders[p->lane+1]-1;
 			}
 		}
 		
 	}
 	else
 	{
-		// read buttons
-		check_buttons();
-
-
 		// shooting
-		if (button_1_4_pressed())
+		if (p->shot_pending)
 		{
-			//play shooting animation
-			Reset0Ref();
-			VIA_t1_cnt_lo = 110;
-			Moveto_d(pyoro.coord.y,pyoro.coord.x);
-			Draw_Line_d(127,pyoro.direction?127:-127);
-			Draw_Line_d(127,pyoro.direction?127:-127);
-			
-			//shoot bean
-			if(pyoro.direction)
-			{
-				distance_x = (bean.coord.x>>1) - (pyoro.coord.x>>1);
-				if(distance_x > 0)
-				{
-					distance_y = (bean.coord.y>>1) + 55;
-					if((distance_x > distance_y) && (distance_x < distance_y+10))
-					{
-						bean.drawn = 0;
-					}
-				}
-			}
-			else if(!pyoro.direction)
-			{
-				distance_x = (bean.coord.x>>1) - (pyoro.coord.x>>1);
-				if(distance_x < 0)
-				{
-					distance_y = (bean.coord.y>>1) + 55;
-					if((-distance_x > distance_y) && (-distance_x < distance_y+10))
-					{
-						bean.drawn = 0;
-					}
-				}
-			}
+			p->shot_pending = 0;
+			p->shooting = 1;	// beans are checked in check_pyoro()
+			p->tongue = 1;		// drawn by draw_player()
 		}
 	}
 }
 
+void move_pyoro()
+{
+	if (pyoro[0].alive)
+	{
+		move_player(&pyoro[0], input_1);
+	}
+	if (pyoro[1].alive)
+	{
+		move_player(&pyoro[1], input_2);
+	}
+}
+
 // ---------------------------------------------------------------------------
-// function to check if pyoro died
+// is the bean in reach of pyoro's tongue
+
+static inline __attribute__((always_inline))
+int in_reach(const struct player* p, const struct object* b)
+{
+	distance_x = (b->coord.x>>1) - (p->coord.x>>1);
+	if (!p->direction)
+	{
+		distance_x = -distance_x;
+	}
+	if(distance_x > 0)
+	{
+		distance_y = (b->coord.y>>1) + 55;
+		return (distance_x > distance_y) && (distance_x < distance_y+10);
+	}
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+// function to check the beans against all players in a single pass: a
+// shooting pyoro catches the first bean in reach, a bean reaching one of
+// pyoro's lanes kills it; returns the number of players still alive
 
 int check_pyoro()
 {
-	if(bean.coord.y < -90)
+	unsigned int i;
+	unsigned int n;
+	int alive = 0;
+	
+	for (i = 0; i < BEAN_COUNT; ++i)
 	{
-		/*
-		if((pyoro.coord.x < bean.coord.x+7) && (pyoro.coord.x > bean.coord.x-7))
+		struct object* b = &beans[i];
+		if (!(beans_live & bean_bits[i]))
 		{
-			return 0;
+			continue;
 		}
-		*/
-		if (pyoro.lane == bean.lane)
+		for (n = 0; n < players; ++n)
 		{
-			return 0;
+			struct player* p = &pyoro[n];
+			if (!p->alive)
+			{
+				continue;
+			}
+			if (p->shooting && in_reach(p, b))
+			{
+				p->shooting = 0;
+				catch_bean(i, p->lane);
+				break;
+			}
+			else if (b->coord.y < -90)
+			{
+				/*
+				if((pyoro.coord.x < bean.coord.x+7) && (pyoro.coord.x > bean.coord.x-7))
+				{
+					return 0;
+				}
+				*/
+				if ((unsigned int) (b->lane - p->lane) < PYORO_LANES)
+				{
+					p->alive = 0;	// the bean hit a tile pyoro stands on
+					play_event(SOUND_DEATH);
+				}
+			}
 		}
 	}
-	else
+	
+	for (n = 0; n < players; ++n)
 	{
-		return 1;
+		pyoro[n].shooting = 0;
+		alive += pyoro[n].alive ? 1 : 0;
 	}
-	return 1;
+	return alive;
 }
 
 
@@ -4,11 +4,23 @@
 
 #pragma once
 
+#include "types.h"
+
 // ---------------------------------------------------------------------------
+
+#define PLAYERS 2	// co-op, both pyoros share the floor and the score
+#define PYORO_VECTORS 7	// vectors of each sprite
+#define PYORO_SHOT_TICKS 10	// ticks a press made while walking waits to fire
+
+extern const int vectors_pyoro_right[PYORO_VECTORS * 3 + 1];
+
 extern int distance_x;
 extern int distance_y;
+extern unsigned long int score;
+extern struct player pyoro[PLAYERS];
+extern unsigned int players;
 
-void init_pyoro();
+void init_pyoro(unsigned int count);
 void move_pyoro();
 void draw_pyoro();
 int check_pyoro();
@@ -0,0 +1,71 @@
+// ***************************************************************************
+// retain
+// ***************************************************************************
+
+#include <vectrex.h>
+
+#include "retain.h"
+
+// ---------------------------------------------------------------------------
+// 1 if main() was entered with a valid block, i.e. after a warm reset
+
+int warm_boot = 0;
+
+// ---------------------------------------------------------------------------
+// checksum over all bytes of the block but the checksum itself
+
+unsigned int retain_checksum()
+{
+	const unsigned int* byte = (const unsigned int*) &retain;
+	unsigned int sum = 0x5A;
+	unsigned int i;
+	for (i = 0; i < sizeof(struct retain_t) - 1; ++i)
+	{
+		sum = (unsigned int) ((sum << 1) | (sum >> 7)) ^ byte[i];	// rotate and add
+	}
+	return sum;
+}
+
+// ---------------------------------------------------------------------------
+// call first thing in main(): restore the random seed after a warm reset,
+// start a fresh block after a cold reset
+
+void init_retain()
+{
+	warm_boot = retain.magic[0] == 'P' && retain.magic[1] == 'Y'
+		&& retain.checksum == retain_checksum();
+	
+	if (warm_boot)
+	{
+		Vec_Random_Seed = retain.seed[0];
+		*(&Vec_Random_Seed + 1) = retain.seed[1];
+		*(&Vec_Random_Seed + 2) = retain.seed[2];
+	}
+	else
+	{
+		retain.magic[0] = 'P';
+		retain.magic[1] = 'Y';
+		retain.hiscore = 0;
+		retain.options = 0;
+		store_retain(0);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// keep hi-score and random seed, call at the end of every game
+
+void store_retain(unsigned long int score)
+{
+	if (score > retain.hiscore)
+	{
+		retain.hiscore = score;
+	}
+	retain.seed[0] = Vec_Random_Seed;
+	retain.seed[1] = *(&Vec_Random_Seed + 1);
+	retain.seed[2] = *(&Vec_Random_Seed + 2);
+	retain.checksum = retain_checksum();
+}
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
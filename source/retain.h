@@ -0,0 +1,39 @@
+// ***************************************************************************
+// retain
+// ***************************************************************************
+
+#pragma once
+
+// ---------------------------------------------------------------------------
+// data kept over a warm reset
+//
+// the startup code initializes all statics again after every reset, so
+// this block lives at a fixed address outside of the linker's ram areas,
+// between the statics (growing up from $C880) and the stack (growing down
+// from $CBEA); tools/footprint.py and tools/stack.py check both against it
+// a cold reset clears the ram, the checksum then marks the block invalid
+
+#define RETAIN_ADDRESS	0xCB00
+#define RETAIN_SIZE		16
+
+struct retain_t
+{
+	char magic[2];				// "PY"
+	unsigned long int hiscore;
+	unsigned int options;		// reserved for game options
+	unsigned int seed[3];		// bios random seed (Vec_Random_Seed)
+	unsigned int checksum;
+};
+
+#define retain (*((struct retain_t*) RETAIN_ADDRESS))
+
+// ---------------------------------------------------------------------------
+
+extern int warm_boot;
+
+void init_retain();
+void store_retain(unsigned long int score);
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
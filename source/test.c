@@ -1,20 +0,0 @@
-// test file
-
-void anus()
-{
-
-	int a = 9;
-	int b = 4;
-	int c = 0;
-
-	if(!(a < b))
-	{
-		c = 2;
-	}
-
-	if(a >= b)
-	{
-		c = 1;
-	}
-
-}
@@ -38,9 +38,7 @@ struct object
 	}coord;
 	
 	unsigned int lane;
-	int speed;
-	const unsigned int scale;
-	int drawn;
+	unsigned int type;	// index into bean_types[], see bean.h
 };
 
 // ---------------------------------------------------------------------------
@@ -61,7 +59,11 @@ struct player
 	unsigned int lane;
 	int speed;
 	enum direction_t direction;
-	const unsigned int scale;
+	unsigned int scale;			// not const, killcam_load() writes the whole struct
+	unsigned int shot_pending;	// ticks left to fire a press made while walking
+	unsigned int shooting;		// tongue out in this tick
+	unsigned int tongue;		// tongue drawn by the next draw_pyoro()
+	unsigned int alive;
 };
 
 
@@ -0,0 +1,113 @@
+// ***************************************************************************
+// arith
+// ***************************************************************************
+
+#include <vectrex.h>
+#include "../config.h"
+#include "arith.h"
+
+// ---------------------------------------------------------------------------
+// multipliers of the shifts
+
+const unsigned int arith_bits[8] =
+{
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80
+};
+
+// ---------------------------------------------------------------------------
+// restoring division, one quotient bit per step
+
+unsigned long int divmod8(unsigned int x, unsigned int divisor)
+{
+	unsigned int remainder = 0;
+	unsigned int i;
+	for (i = 0; i < 8; ++i)
+	{
+		unsigned int carry = remainder & 0x80;	// 9th bit after the shift
+		remainder = (unsigned int) ((remainder << 1) | (x >> 7));
+		x = (unsigned int) (x << 1);
+		if (carry || remainder >= divisor)
+		{
+			remainder = (unsigned int) (remainder - divisor);
+			x |= 1;		// quotient bits are shifted in where x is shifted out
+		}
+	}
+	return ((unsigned long int) remainder << 8) | x;
+}
+
+// ---------------------------------------------------------------------------
+// one operation per function, the long version the game used before next
+// to its replacement; compare the cycles with tools\wcet.py --functions
+
+#if DEBUG
+
+volatile unsigned int bench_x = 201;
+volatile unsigned int bench_n = 3;
+volatile unsigned long int bench_wide = 201;
+volatile unsigned long int bench_result;
+
+void bench_mul_long(void)
+{
+	bench_result = bench_wide * (unsigned long int) bench_n;
+}
+
+void bench_mul8(void)
+{
+	bench_result = mul8(bench_x, bench_n);
+}
+
+void bench_shl_long(void)
+{
+	bench_result = (unsigned long int) bench_x << (unsigned long int) bench_n;
+}
+
+void bench_shl8(void)
+{
+	bench_result = shl8(bench_x, bench_n);
+}
+
+void bench_shr_long(void)
+{
+	bench_result = (unsigned long int) bench_x >> (unsigned long int) bench_n;
+}
+
+void bench_shr8(void)
+{
+	bench_result = shr8(bench_x, bench_n);
+}
+
+void bench_div10_long(void)
+{
+	bench_result = (unsigned long int) bench_x / 10UL;
+}
+
+void bench_div10(void)
+{
+	bench_result = div10(bench_x);
+}
+
+void bench_mod10_long(void)
+{
+	bench_result = (unsigned long int) bench_x % 10UL;
+}
+
+void bench_mod10(void)
+{
+	bench_result = mod10(bench_x);
+}
+
+void bench_div_long(void)
+{
+	bench_result = (unsigned long int) bench_x / (unsigned long int) bench_n;
+}
+
+void bench_div8(void)
+{
+	bench_result = div8(bench_x, bench_n);
+}
+
+#endif
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -0,0 +1,86 @@
+// ***************************************************************************
+// arith
+// ***************************************************************************
+
+#pragma once
+
+// ---------------------------------------------------------------------------
+// 8 bit arithmetic without libgcc
+//
+// gcc6809 has no variable shift and no 8 bit division, the long (16 bit)
+// versions call __ashlhi3, __lshrhi3 and __udivhi3 (120 to 650 cycles);
+// the product of two zero extended bytes is compiled to MUL (11 cycles),
+// so shifts and divisions by constants are done as multiplications:
+//
+//   shl8(x, n)   low byte of x * 2^n
+//   shr8(x, n)   high byte of x * 2^(8 - n)
+//   div10(x)     x * 205 / 2048, exact for x < 1029
+//   div8(x, d)   shift and subtract, 8 steps
+//
+// shift counts of 8 and more give 0 (-1 for a negative asr8()); the cycles of every routine next to the
+// long version it replaces are listed by tools\wcet.py --functions for the
+// bench_* functions of a DEBUG=1 build (arith.c)
+
+extern const unsigned int arith_bits[8];	// 2^n
+
+// ---------------------------------------------------------------------------
+
+static inline __attribute__((always_inline))
+unsigned long int mul8(unsigned int a, unsigned int b)
+{
+	return (unsigned long int) a * (unsigned long int) b;
+}
+
+static inline __attribute__((always_inline))
+unsigned int shl8(unsigned int x, unsigned int n)
+{
+	return n < 8 ? (unsigned int) mul8(x, arith_bits[n]) : 0;
+}
+
+static inline __attribute__((always_inline))
+unsigned int shr8(unsigned int x, unsigned int n)
+{
+	if (!n)
+	{
+		return x;
+	}
+	return n < 8 ? (unsigned int) (mul8(x, arith_bits[8 - n]) >> 8) : 0;
+}
+
+// arithmetic shift, the sign is kept
+static inline __attribute__((always_inline))
+int asr8(int x, unsigned int n)
+{
+	return x < 0 ? (int) ~shr8((unsigned int) ~x, n) : (int) shr8((unsigned int) x, n);
+}
+
+static inline __attribute__((always_inline))
+unsigned int div10(unsigned int x)
+{
+	return (unsigned int) (mul8(x, 205) >> 8) >> 3;
+}
+
+static inline __attribute__((always_inline))
+unsigned int mod10(unsigned int x)
+{
+	return x - (unsigned int) mul8(div10(x), 10);
+}
+
+// quotient in the low byte, remainder in the high byte; divisor not 0
+unsigned long int divmod8(unsigned int x, unsigned int divisor);
+
+static inline __attribute__((always_inline))
+unsigned int div8(unsigned int x, unsigned int divisor)
+{
+	return (unsigned int) divmod8(x, divisor);
+}
+
+static inline __attribute__((always_inline))
+unsigned int mod8(unsigned int x, unsigned int divisor)
+{
+	return (unsigned int) (divmod8(x, divisor) >> 8);
+}
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -0,0 +1,202 @@
+// ***************************************************************************
+// digits
+// ***************************************************************************
+
+#include <vectrex.h>
+#include "utils.h"
+#include "digits.h"
+
+// ---------------------------------------------------------------------------
+// seven segment glyphs, 40 wide and 80 high, drawn from the bottom left
+// corner; the last move of every list goes to the bottom left corner of
+// the next glyph
+
+const int vectors_digit_0[] =
+{
+	-1,0,40,
+	-1,40,0,
+	-1,40,0,
+	-1,0,-40,
+	-1,-40,0,
+	-1,-40,0,
+	0,0,70,
+	1
+};
+
+const int vectors_digit_1[] =
+{
+	0,80,40,
+	-1,-40,0,
+	-1,-40,0,
+	0,0,30,
+	1
+};
+
+const int vectors_digit_2[] =
+{
+	0,80,0,
+	-1,0,40,
+	-1,-40,0,
+	-1,0,-40,
+	-1,-40,0,
+	-1,0,40,
+	0,0,30,
+	1
+};
+
+const int vectors_digit_3[] =
+{
+	-1,0,40,
+	-1,40,0,
+	0,40,-40,
+	-1,0,40,
+	-1,-40,0,
+	-1,0,-40,
+	0,-40,70,
+	1
+};
+
+const int vectors_digit_4[] =
+{
+	0,80,0,
+	-1,-40,0,
+	-1,0,40,
+	0,40,0,
+	-1,-40,0,
+	-1,-40,0,
+	0,0,30,
+	1
+};
+
+const int vectors_digit_5[] =
+{
+	-1,0,40,
+	-1,40,0,
+	-1,0,-40,
+	-1,40,0,
+	-1,0,40,
+	0,-80,30,
+	1
+};
+
+const int vectors_digit_6[] =
+{
+	0,80,40,
+	-1,0,-40,
+	-1,-40,0,
+	-1,0,40,
+	-1,-40,0,
+	-1,0,-40,
+	-1,40,0,
+	0,-40,70,
+	1
+};
+
+const int vectors_digit_7[] =
+{
+	0,80,0,
+	-1,0,40,
+	-1,-40,0,
+	-1,-40,0,
+	0,0,30,
+	1
+};
+
+const int vectors_digit_8[] =
+{
+	0,40,40,
+	-1,40,0,
+	-1,0,-40,
+	-1,-40,0,
+	-1,-40,0,
+	-1,0,40,
+	-1,40,0,
+	-1,0,-40,
+	0,-40,70,
+	1
+};
+
+const int vectors_digit_9[] =
+{
+	-1,0,40,
+	-1,40,0,
+	-1,40,0,
+	-1,0,-40,
+	-1,-40,0,
+	-1,0,40,
+	0,-40,30,
+	1
+};
+
+const int* const digit_glyphs[10] =
+{
+	vectors_digit_0, vectors_digit_1, vectors_digit_2, vectors_digit_3,
+	vectors_digit_4, vectors_digit_5, vectors_digit_6, vectors_digit_7,
+	vectors_digit_8, vectors_digit_9
+};
+
+// ---------------------------------------------------------------------------
+// decimal conversion by subtraction, at most 9 per digit instead of a
+// 16 bit division and modulo
+
+const unsigned long int digit_powers[DIGITS_NUMBER - 1] =
+{
+	10000, 1000, 100, 10
+};
+
+// ---------------------------------------------------------------------------
+// move the beam to the bottom left corner of the first glyph
+
+static inline __attribute__((always_inline))
+void digits_start(int y, int x)
+{
+	beam_reset();
+	beam_scale(110);
+	beam_moveto(y, x);
+	beam_scale(DIGITS_SCALE);
+}
+
+// ---------------------------------------------------------------------------
+// draw a binary value at (y, x), leading zeros included
+
+void draw_number(int y, int x, unsigned long int value)
+{
+	unsigned int digits[DIGITS_NUMBER];
+	unsigned int i;
+	for (i = 0; i < DIGITS_NUMBER - 1; ++i)
+	{
+		unsigned int digit = 0;
+		while (value >= digit_powers[i])
+		{
+			value -= digit_powers[i];
+			++digit;
+		}
+		digits[i] = digit;
+	}
+	digits[DIGITS_NUMBER - 1] = (unsigned int) value;
+
+	digits_start(y, x);
+	for (i = 0; i < DIGITS_NUMBER; ++i)
+	{
+		beam_list(digit_glyphs[digits[i]]);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// draw packed bcd at (y, x), bytes must not be 0
+
+void draw_bcd(int y, int x, const unsigned int* bcd, unsigned int bytes)
+{
+	digits_start(y, x);
+	do
+	{
+		beam_list(digit_glyphs[*bcd >> 4]);
+		beam_list(digit_glyphs[*bcd & 15]);
+		++bcd;
+	}
+	while (--bytes);
+}
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
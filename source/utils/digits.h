@@ -0,0 +1,32 @@
+// ***************************************************************************
+// digits
+// ***************************************************************************
+//
+// numbers drawn as seven segment vector glyphs instead of bios raster text;
+// every glyph is a Draw_VLp() list that ends with the relative move to the
+// next glyph, so a number is one reset and move plus one list per digit
+//
+// cost of a 5 digit number with the bounds of tools/wcet.txt (compare with
+// python tools\wcet.py --functions):
+//   print_long_int()  5 x (__umodhi3 + __udivhi3) + Print_Str_yx   ~11000
+//   draw_number()     4 x 9 subtractions + 5 x Draw_VLp            ~ 4400
+// draw_bcd() skips the conversion, about 650 cycles per digit
+
+#pragma once
+
+// ---------------------------------------------------------------------------
+
+#define DIGITS_SCALE 12		// glyphs are 80 units high, 70 units apart
+#define DIGITS_NUMBER 5		// digits of draw_number(), enough for 65535
+
+extern const int* const digit_glyphs[10];
+
+// draw a binary value with DIGITS_NUMBER digits at (y, x), scale 110
+void draw_number(int y, int x, unsigned long int value);
+
+// draw packed bcd, two digits per byte, high nibble first
+void draw_bcd(int y, int x, const unsigned int* bcd, unsigned int bytes);
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -0,0 +1,104 @@
+// ***************************************************************************
+// pace
+// ***************************************************************************
+
+#include <vectrex.h>
+#include "pace.h"
+
+// ---------------------------------------------------------------------------
+// refresh periods, shortest first
+
+const struct pace_level_t pace_levels[PACE_LEVELS] =
+{
+	{0xA8, 0x61, 100},	// 25000 cycles, 60 Hz
+	{0x6C, 0x6B, 110},	// 27500 cycles, 55 Hz
+	{0x30, 0x75, 120},	// 30000 cycles, 50 Hz
+	{0xD6, 0x83, 135}	// 33750 cycles, 44 Hz
+};
+
+struct pace_t pace =
+{
+	PACE_START,	// level
+	0,			// calm
+	0,			// time
+	0			// changes
+};
+
+// ---------------------------------------------------------------------------
+// switch the refresh period, used from the next Wait_Recal() on
+
+static inline __attribute__((always_inline))
+void pace_level(unsigned int level)
+{
+	pace.level = level;
+	pace.calm = 0;
+	++pace.changes;
+	Vec_Rfrsh_lo = pace_levels[level].lo;
+	Vec_Rfrsh_hi = pace_levels[level].hi;
+}
+
+// ---------------------------------------------------------------------------
+// call once before the first frame
+
+void init_pace(void)
+{
+	pace_level(PACE_START);
+	pace.changes = 0;
+	pace.time = 0;
+}
+
+// ---------------------------------------------------------------------------
+// call right after Wait_Recal(), returns the number of game logic ticks
+// to run in this frame; time stays below PACE_TICK, so time + the longest
+// period fits into a byte
+
+unsigned int pace_ticks(void)
+{
+	unsigned int ticks = 0;
+	pace.time += pace_levels[pace.level].units;
+	while (pace.time >= PACE_TICK)
+	{
+		pace.time -= PACE_TICK;
+		++ticks;
+	}
+	return ticks;
+}
+
+// ---------------------------------------------------------------------------
+// call at the very end of a frame's work: timer 2 high byte is the time
+// left in the frame (0 if it is overrun); reading the high byte does not
+// clear the flag Wait_Recal() waits for
+
+void pace_frame_end(void)
+{
+	unsigned int left = (VIA_int_flags & 0b00100000) ? 0 : VIA_t2_hi;
+	unsigned int level = pace.level;
+	
+	if (left < PACE_MARGIN)
+	{
+		if (level < PACE_LEVELS - 1)
+		{
+			pace_level(level + 1);
+		}
+		else
+		{
+			pace.calm = 0;
+		}
+	}
+	else if (level > 0
+		&& left >= pace_levels[level].hi - pace_levels[level - 1].hi + PACE_MARGIN)
+	{
+		if (++pace.calm == PACE_CALM)
+		{
+			pace_level(level - 1);
+		}
+	}
+	else
+	{
+		pace.calm = 0;
+	}
+}
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -0,0 +1,52 @@
+// ***************************************************************************
+// pace
+// ***************************************************************************
+
+#pragma once
+
+// ---------------------------------------------------------------------------
+// frame pacing: the refresh period Wait_Recal() loads into VIA timer 2
+// (Vec_Rfrsh) follows the measured load of the frames
+//
+// light frames run at 60 Hz for low latency; a frame that ends with less
+// than PACE_MARGIN * 256 cycles left switches to the next longer period at
+// once, PACE_CALM frames in a row that would also fit into the next
+// shorter period switch back; the period never gets longer than 33750
+// cycles (44 Hz), below that the picture flickers
+//
+// game logic runs in fixed ticks of 30000 cycles (50 per second) whatever
+// the refresh rate: pace_ticks() returns how many ticks are due in this
+// frame (0 to 2), so the game runs at the same speed at every rate
+//
+// pace.changes counts the changes of the refresh period
+
+#define PACE_LEVELS	4	// 25000, 27500, 30000, 33750 cycles
+#define PACE_START	2	// 30000 cycles, the bios default
+#define PACE_TICK	120	// game logic tick in units of 250 cycles
+#define PACE_MARGIN	8	// cycles / 256 kept free at the end of a frame
+#define PACE_CALM	50	// frames with room before a shorter period
+
+struct pace_level_t
+{
+	unsigned int lo;	// Vec_Rfrsh, low byte first
+	unsigned int hi;
+	unsigned int units;	// period in units of 250 cycles
+};
+
+struct pace_t
+{
+	unsigned int level;
+	unsigned int calm;
+	unsigned int time;	// units of 250 cycles not yet used by a tick
+	unsigned int changes;
+};
+
+extern struct pace_t pace;
+
+void init_pace(void);
+unsigned int pace_ticks(void);
+void pace_frame_end(void);
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
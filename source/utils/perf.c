@@ -0,0 +1,81 @@
+// ***************************************************************************
+// perf
+// ***************************************************************************
+
+#include <vectrex.h>
+#include "perf.h"
+
+#if DEBUG
+
+// ---------------------------------------------------------------------------
+// frame timing and counters, sampled by the harness
+
+struct perf_t perf =
+{
+	{'P', 'F'},		// magic
+	0,				// frame
+	0,				// remaining
+	0xFF,			// worst
+	0xFF,			// window_worst
+	0,				// window_frames
+	0,				// overruns
+	{0, 0, 0, 0},	// phase
+	0,				// spawned
+	0,				// destroyed
+	0,				// psg_writes
+	0,				// mark
+	0,				// boot
+	0,				// writes_saved
+	0,				// calls_saved
+	0,				// players
+	0,				// refresh
+	0,				// rate_changes
+	{0, 0, 0, 0},	// bench
+	0				// slices
+};
+
+// ---------------------------------------------------------------------------
+// call right after Wait_Recal()
+
+void perf_frame_begin(void)
+{
+	++perf.frame;
+	perf.phase[PERF_INPUT] = 0;
+	perf.phase[PERF_UPDATE] = 0;
+	perf.phase[PERF_DRAW] = 0;
+	perf.phase[PERF_SOUND] = 0;
+	perf.writes_saved = 0;
+	perf.calls_saved = 0;
+	perf.slices = 0;
+	perf.mark = perf_timer();
+}
+
+// ---------------------------------------------------------------------------
+// call once at the end of a frame's work, before the next Wait_Recal()
+
+void perf_frame_end(void)
+{
+	unsigned int remaining = perf_timer();
+	
+	perf.remaining = remaining;
+	if (remaining == 0)
+	{
+		++perf.overruns;
+	}
+	if (remaining < perf.window_worst)
+	{
+		perf.window_worst = remaining;
+	}
+	if (++perf.window_frames == PERF_WINDOW)
+	{
+		perf.worst = perf.window_worst;
+		perf.window_worst = 0xFF;
+		perf.window_frames = 0;
+	}
+}
+
+#endif
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -0,0 +1,148 @@
+// ***************************************************************************
+// perf
+// ***************************************************************************
+
+#pragma once
+#include <vectrex.h>
+#include "../config.h"
+
+// ---------------------------------------------------------------------------
+// frame timing and counters, only compiled with DEBUG=1
+//
+// Wait_Recal() restarts VIA timer 2 with the refresh period (Vec_Rfrsh,
+// 30000 cycles) and waits for it to expire, so the timer value at the end
+// of a frame's work is the number of cycles left in the frame; only the
+// high byte is read (units of 256 cycles), reading the low byte would
+// clear the timer flag Wait_Recal() is waiting for
+//
+// the harness finds the block through the symbol _perf in the linker map
+// (tools/perf.py address), checks the magic and copies the block every
+// time Wait_Recal() is entered; tools/perf.py turns the copies into csv
+//
+// block layout (6809 big endian, one byte per field unless noted):
+//  0 magic "PF" (2 bytes)
+//  2 frame number (2 bytes)
+//  4 cycles / 256 left in the last frame
+//  5 least cycles / 256 left in a frame of the last window
+//  6 least cycles / 256 left in the current window
+//  7 frames counted in the current window
+//  8 overrun frames
+//  9 cycles / 256 of the input, update, draw and sound phase (4 bytes)
+// 13 objects spawned
+// 14 objects destroyed
+// 15 psg register writes
+// 16 timer at the last phase mark
+// 17 frames from reset to the first gameplay frame, 0 before it (2 bytes)
+// 19 beam register writes skipped in this frame (utils.h beam_*)
+// 20 beam bios calls skipped in this frame
+// 21 players in the current game, to compare the frame cost of 1 and 2
+// 22 refresh period level (utils/pace.h, 0 = 60 Hz ... 3 = 44 Hz)
+// 23 refresh period changes
+// 24 cycles / 16 of Draw_VLp() and draw_vectors() for the pyoro and the
+//    bean sprite, measured once at startup (4 bytes, utils/vectors.h)
+// 28 slices of game logic run during beam moves in this frame (bean.h)
+//
+// the cycles left are relative to the refresh period of that frame
+
+#define PERF_WINDOW 50	// frames per worst case window (1 second)
+
+#define PERF_INPUT	0
+#define PERF_UPDATE	1
+#define PERF_DRAW	2
+#define PERF_SOUND	3
+#define PERF_PHASES	4
+
+struct perf_t
+{
+	char magic[2];
+	unsigned long int frame;
+	unsigned int remaining;
+	unsigned int worst;
+	unsigned int window_worst;
+	unsigned int window_frames;
+	unsigned int overruns;
+	unsigned int phase[PERF_PHASES];
+	unsigned int spawned;
+	unsigned int destroyed;
+	unsigned int psg_writes;
+	unsigned int mark;
+	unsigned long int boot;
+	unsigned int writes_saved;
+	unsigned int calls_saved;
+	unsigned int players;
+	unsigned int refresh;
+	unsigned int rate_changes;
+	unsigned int bench[4];
+	unsigned int slices;
+};
+
+#if DEBUG
+
+extern struct perf_t perf;
+
+// timer 2 high byte, 0 once the frame is overrun
+static inline __attribute__((always_inline))
+unsigned int perf_timer(void)
+{
+	return (VIA_int_flags & 0b00100000) ? 0 : VIA_t2_hi;
+}
+
+// add the time since the last mark to a phase
+static inline __attribute__((always_inline))
+void perf_phase(unsigned int phase)
+{
+	unsigned int now = perf_timer();
+	perf.phase[phase] += perf.mark - now;
+	perf.mark = now;
+}
+
+// bios frame counter (reset to 0 on every reset) at the first gameplay
+// frame, call once per frame while the game is played
+static inline __attribute__((always_inline))
+void perf_boot(void)
+{
+	if (!perf.boot)
+	{
+		perf.boot = *((volatile unsigned long int*) &Vec_Loop_Count);
+	}
+}
+
+#define perf_count(counter) (++perf.counter)
+#define perf_add(counter, n) (perf.counter += (n))
+#define perf_set(counter, n) (perf.counter = (n))
+
+void perf_frame_begin(void);
+void perf_frame_end(void);
+
+#else
+
+static inline __attribute__((always_inline))
+void perf_phase(unsigned int phase)
+{
+	(void) phase;
+}
+
+static inline __attribute__((always_inline))
+void perf_boot(void)
+{
+}
+
+#define perf_count(counter) ((void) 0)
+#define perf_add(counter, n) ((void) 0)
+#define perf_set(counter, n) ((void) 0)
+
+static inline __attribute__((always_inline))
+void perf_frame_begin(void)
+{
+}
+
+static inline __attribute__((always_inline))
+void perf_frame_end(void)
+{
+}
+
+#endif
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
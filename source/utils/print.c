@@ -3,6 +3,7 @@
 // ***************************************************************************
 
 #include <vectrex.h>
+#include "utils.h"
 
 // ---------------------------------------------------------------------------
 // print a c string (with \0 at the end) at absolute coordinates (y, x)
@@ -21,6 +22,7 @@ void print_str(int y, int x, char* text)
 	message[i - 1] = '\x80';
 	Reset0Ref_D0();
 	Print_Str_yx((void*) &message[0]);
+	beam_lost();
 }
 
 // ---------------------------------------------------------------------------
@@ -35,12 +37,13 @@ void print_int(int y, int x, unsigned int z)
 	unsigned int i = 4;
 	do
 	{
-		message[i--] = (char) ('0' + z % 10);
-		z = z / 10;
+		message[i--] = (char) ('0' + mod10(z));
+		z = div10(z);
 	}
 	while (i > 1);	
 	Reset0Ref_D0();
 	Print_Str_yx((void*) &message[0]);
+	beam_lost();
 }
 
 // ---------------------------------------------------------------------------
@@ -61,6 +64,7 @@ void print_bin(int y, int x, unsigned int z)
 	while (i > 1);	
 	Reset0Ref_D0();
 	Print_Str_yx((void*) &message[0]);
+	beam_lost();
 }
 
 // ---------------------------------------------------------------------------
@@ -81,6 +85,7 @@ void print_long_int(int y, int x, unsigned long int z)
 	while (i > 1);	
 	Reset0Ref_D0();
 	Print_Str_yx((void*) &message[0]);
+	beam_lost();
 }
 
 // ***************************************************************************
@@ -5,6 +5,7 @@
 #include <vectrex.h>
 #include "sound.h"
 #include "utils.h"
+#include "perf.h"
 
 // ---------------------------------------------------------------------------
 // Music data format:
@@ -71,12 +72,41 @@ const struct sound_explosion_t explosion_off =
 	0b00111111, SOUND_EXPL_RISE, SOUND_VOL_FALL, 128U
 }; 
 
+// ---------------------------------------------------------------------------
+// effects of the game events, indexed by SOUND_*
+
+const struct sound_explosion_t explosion_break =
+{
+	0b00111000, SOUND_EXPL_FALL, SOUND_VOL_FALL, 0x40U
+};
+
+const struct sound_explosion_t explosion_catch =
+{
+	0b00000001, SOUND_EXPL_RISE, SOUND_VOL_FALL, 0x60U
+};
+
+const struct sound_explosion_t explosion_death =
+{
+	0b00111111, SOUND_EXPL_RISE, SOUND_VOL_FALL, 0x04U
+};
+
+const struct sound_explosion_t* const sound_events[SOUND_EVENTS] =
+{
+	&explosion_off, &explosion_break, &explosion_catch, &explosion_death
+};
+
 // ---------------------------------------------------------------------------
 // global ram variables
 
 const struct sound_music_t* current_music = &music_off;
 const struct sound_explosion_t* current_explosion = &explosion_off;
 
+struct sound_t sound =
+{
+	SOUND_NONE,		// pending
+	SOUND_NONE		// playing
+};
+
 // ---------------------------------------------------------------------------
 // initialize global variables
 
@@ -84,6 +114,8 @@ void sound_init()
 {
 	current_music = &music_off;
 	current_explosion = &explosion_off;
+	sound.pending = SOUND_NONE;
+	sound.playing = SOUND_NONE;
 }
 
 // ---------------------------------------------------------------------------
@@ -141,6 +173,33 @@ void play_tune(unsigned int channel, long unsigned int frequency, unsigned int v
 	unsigned int z = channel + 8U;
 	Sound_Byte(z, volume);
 	Sound_Byte(7, 0b00111000);
+	perf_add(psg_writes, 4);
+}
+
+// ---------------------------------------------------------------------------
+// one audio tick, call right after Wait_Recal(); the bios handlers want
+// the direct page at $C8, Do_Sound() at $D0
+
+void update_sound()
+{
+	// the explosion timer runs down to 0 when an explosion is over, the
+	// flag is only the start request Explosion_Snd() takes
+	if (!Vec_Expl_Timer)
+	{
+		sound.playing = SOUND_NONE;
+	}
+	if (sound.pending > sound.playing)
+	{
+		play_explosion(sound_events[sound.pending]);
+		sound.playing = sound.pending;
+	}
+	sound.pending = SOUND_NONE;
+	
+	DP_to_C8();
+	Explosion_Snd(current_explosion);
+	Init_Music_chk(current_music);
+	DP_to_D0();
+	Do_Sound();
 }
 
 // ***************************************************************************
@@ -87,6 +87,41 @@ void stop_explosion();
 
 void play_tune(unsigned int channel, long unsigned int frequency, unsigned int volume);
 
+// ---------------------------------------------------------------------------
+// game events as sound effects
+//
+// play_event() only notes the event, the highest number of a frame wins
+// and a playing effect is only cut by a higher one; update_sound() runs
+// once per frame right after Wait_Recal(): it starts at most one effect,
+// runs the bios explosion and music handlers and writes the psg, so the
+// audio tick costs the same however many events fire (tools/wcet.txt,
+// sound column of tools/perf.py)
+
+#define SOUND_NONE	0
+#define SOUND_BREAK	1	// a bean breaks a tile
+#define SOUND_CATCH	2	// a pyoro catches a bean
+#define SOUND_DEATH	3	// a pyoro is hit
+#define SOUND_EVENTS	4
+
+struct sound_t
+{
+	unsigned int pending;	// event to start in the next audio tick
+	unsigned int playing;	// event of the effect still playing
+};
+
+extern struct sound_t sound;
+
+static inline __attribute__((always_inline))
+void play_event(unsigned int event)
+{
+	if (event > sound.pending)
+	{
+		sound.pending = event;
+	}
+}
+
+void update_sound();
+
 // ---------------------------------------------------------------------------
 
 #define __N_G2	0x00U
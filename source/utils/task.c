@@ -0,0 +1,35 @@
+// ***************************************************************************
+// task
+// ***************************************************************************
+
+#include "task.h"
+
+// ---------------------------------------------------------------------------
+// resume every running task of the table once, call once per frame
+
+void run_tasks(const struct task_entry_t* table, unsigned int count)
+{
+	while (count--)
+	{
+		if (table->task->resume)
+		{
+			table->run(table->task);
+		}
+		++table;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// stop every task of the table
+
+void stop_tasks(const struct task_entry_t* table, unsigned int count)
+{
+	while (count--)
+	{
+		(table++)->task->resume = 0;
+	}
+}
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -0,0 +1,96 @@
+// ***************************************************************************
+// task
+// ***************************************************************************
+
+#pragma once
+
+// ---------------------------------------------------------------------------
+// stackless coroutines (protothreads) for sequences over several frames
+//
+// a task is a function that is resumed once per frame by run_tasks() and
+// continues where it stopped the frame before, so a sequence like "burst,
+// wait 40 frames, switch state" is written as straight code instead of a
+// counter in a global; the resume point is kept as a label address (gnu c
+// labels as values), a task costs 3 bytes of ram
+//
+// local variables are lost at every wait, keep state in globals; only one
+// TASK_* macro per source line (the labels are named after the line)
+//
+// resuming a task costs the jsr through the task table, the test of the
+// resume point and one jmp through it, see run_tasks in
+// tools\wcet.py --functions (about 50 cycles)
+//
+// void blink(struct task_t* t)
+// {
+//     TASK_BEGIN(t);
+//     show = 1;
+//     TASK_WAIT(t, 25);
+//     show = 0;
+//     TASK_END(t);
+// }
+
+struct task_t
+{
+	void* resume;		// 0 = not running, TASK_FIRST = start from the top
+	unsigned int wait;	// frames left in TASK_WAIT
+};
+
+struct task_entry_t
+{
+	struct task_t* task;
+	void (*run)(struct task_t* t);
+};
+
+#define TASK_FIRST ((void*) 1)
+
+#define TASK_CAT2(a, b) a ## b
+#define TASK_CAT(a, b) TASK_CAT2(a, b)
+#define TASK_HERE TASK_CAT(task_line_, __LINE__)
+
+// first statement of a task function
+#define TASK_BEGIN(t) \
+	do { if ((t)->resume != TASK_FIRST) goto *(t)->resume; } while (0)
+
+// continue in the next frame
+#define TASK_YIELD(t) \
+	do { (t)->resume = &&TASK_HERE; return; TASK_HERE: ; } while (0)
+
+// continue after frames frames (at most 255)
+#define TASK_WAIT(t, frames) \
+	do { (t)->wait = (frames); (t)->resume = &&TASK_HERE; \
+	TASK_HERE: if ((t)->wait) { --(t)->wait; return; } } while (0)
+
+// continue in the first frame cond is true, checked once per frame
+#define TASK_WAIT_UNTIL(t, cond) \
+	do { (t)->resume = &&TASK_HERE; TASK_HERE: if (!(cond)) return; } while (0)
+
+// last statement of a task function, the task stops
+#define TASK_END(t) \
+	do { (t)->resume = 0; return; } while (0)
+
+// ---------------------------------------------------------------------------
+
+static inline __attribute__((always_inline))
+void task_start(struct task_t* t)
+{
+	t->resume = TASK_FIRST;
+}
+
+static inline __attribute__((always_inline))
+void task_stop(struct task_t* t)
+{
+	t->resume = 0;
+}
+
+static inline __attribute__((always_inline))
+int task_running(const struct task_t* t)
+{
+	return t->resume != 0;
+}
+
+void run_tasks(const struct task_entry_t* table, unsigned int count);
+void stop_tasks(const struct task_entry_t* table, unsigned int count);
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
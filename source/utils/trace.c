@@ -0,0 +1,54 @@
+// ***************************************************************************
+// trace
+// ***************************************************************************
+
+#include <vectrex.h>
+#include "trace.h"
+
+#if TRACE
+
+// ---------------------------------------------------------------------------
+// trace block, sampled by the harness
+
+struct trace_t trace =
+{
+	{'T', 'R'},	// magic
+	0,			// frame
+	0,			// count
+	0,			// overflow
+	{{0, 0, 0}}	// records
+};
+
+// ---------------------------------------------------------------------------
+// start recording a new frame, call right after Wait_Recal()
+
+void trace_frame(void)
+{
+	++trace.frame;
+	trace.count = 0;
+	trace.overflow = 0;
+}
+
+// ---------------------------------------------------------------------------
+// append a single beam operation to the current frame
+
+void trace_record(unsigned int op, int y, int x)
+{
+	if (trace.count < TRACE_SIZE)
+	{
+		struct trace_record_t* record = &trace.record[trace.count++];
+		record->op = op;
+		record->y = y;
+		record->x = x;
+	}
+	else
+	{
+		++trace.overflow;
+	}
+}
+
+#endif
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
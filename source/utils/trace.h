@@ -0,0 +1,137 @@
+// ***************************************************************************
+// trace
+// ***************************************************************************
+
+#pragma once
+#include <vectrex.h>
+#include "../config.h"
+
+// ---------------------------------------------------------------------------
+// beam trace, only compiled with TRACE=1
+//
+// every reset, move, line, vector list, scale and intensity change of a
+// frame is appended to the ram block below; the harness copies the header
+// and the first count records of the block each time Wait_Recal() is
+// entered and appends them to a binary trace file, tools/trace.py then
+// reports lit length, blank travel, resets and overdraw per frame
+//
+// block layout (6809 big endian):
+// 2 bytes magic "TR"
+// 2 bytes frame number
+// 1 byte  number of records in this frame
+// 1 byte  number of records dropped because the block was full
+// 3 bytes per record: operation, y, x (vector lists: address hi, lo)
+//
+// dot lists live in ram and are not expanded by tools/trace.py, only the
+// number of dots is recorded
+
+#define TRACE_SIZE 48
+
+#define TRACE_RESET		0	// integrators zeroed
+#define TRACE_MOVE		1	// blank move, relative y, x
+#define TRACE_LINE		2	// lit line, relative y, x
+#define TRACE_LIST		3	// Draw_VLp, address of the vector list
+#define TRACE_SCALE		4	// VIA_t1_cnt_lo, value in y
+#define TRACE_INTENSITY	5	// beam intensity, value in y
+#define TRACE_INPUT		6	// input sampled, bits of player 1 in y, player 2 in x
+#define TRACE_DOTS		7	// Dot_List, number of dots in y
+
+struct trace_record_t
+{
+	unsigned int op;
+	int y;
+	int x;
+};
+
+struct trace_t
+{
+	char magic[2];
+	unsigned long int frame;
+	unsigned int count;
+	unsigned int overflow;
+	struct trace_record_t record[TRACE_SIZE];
+};
+
+// ---------------------------------------------------------------------------
+
+#if TRACE
+
+extern struct trace_t trace;
+
+void trace_frame(void);
+void trace_record(unsigned int op, int y, int x);
+
+#else
+
+static inline __attribute__((always_inline))
+void trace_frame(void)
+{
+}
+
+static inline __attribute__((always_inline))
+void trace_record(unsigned int op, int y, int x)
+{
+	(void) op;
+	(void) y;
+	(void) x;
+}
+
+#endif
+
+// ---------------------------------------------------------------------------
+// traced bios calls, use these in all drawing code; without TRACE they are
+// exactly the plain bios calls
+
+static inline __attribute__((always_inline))
+void trace_Reset0Ref(void)
+{
+	trace_record(TRACE_RESET, 0, 0);
+	Reset0Ref();
+}
+
+static inline __attribute__((always_inline))
+void trace_Moveto_d(int y, int x)
+{
+	trace_record(TRACE_MOVE, y, x);
+	Moveto_d(y, x);
+}
+
+static inline __attribute__((always_inline))
+void trace_Draw_Line_d(int y, int x)
+{
+	trace_record(TRACE_LINE, y, x);
+	Draw_Line_d(y, x);
+}
+
+static inline __attribute__((always_inline))
+void trace_Draw_VLp(const void* list)
+{
+	trace_record(TRACE_LIST, (int) ((unsigned long int) list >> 8), (int) ((unsigned long int) list & 255UL));
+	Draw_VLp((void*) list);
+}
+
+static inline __attribute__((always_inline))
+void trace_Dot_List(const void* list, unsigned int count)
+{
+	trace_record(TRACE_DOTS, (int) count, 0);
+	Vec_Misc_Count = count - 1;
+	Dot_List((void*) list);
+}
+
+static inline __attribute__((always_inline))
+void trace_scale(unsigned int scale)
+{
+	trace_record(TRACE_SCALE, (int) scale, 0);
+	VIA_t1_cnt_lo = scale;
+}
+
+static inline __attribute__((always_inline))
+void trace_Intensity_5F(void)
+{
+	trace_record(TRACE_INTENSITY, 0x5F, 0);
+	Intensity_5F();
+}
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
@@ -6,11 +6,14 @@
 #include "utils.h"
 
 // ---------------------------------------------------------------------------
+// beam state, see utils.h
 
-void Sync()
+struct beam_t beam =
 {
-	sync();
-}
+	BEAM_UNKNOWN,	// scale
+	BEAM_UNKNOWN,	// intensity
+	0				// zeroed
+};
 
 // ***************************************************************************
 // end of file
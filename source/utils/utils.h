@@ -5,12 +5,138 @@
 #pragma once
 #include <vectrex.h>
 #include "sound.h"
+#include "trace.h"
+#include "perf.h"
+#include "vectors.h"
+#include "arith.h"
 
 // ---------------------------------------------------------------------------
 // scale factor used for all absolute sprite coordinates
 
 #define GRID_SCALE 0x7F
 
+// ---------------------------------------------------------------------------
+// beam state: scale, intensity and zeroed integrators as last set by the
+// game; the beam_* functions skip register writes and bios calls that
+// would not change anything and count them in the perf block
+//
+// Wait_Recal() and the bios text routines move the beam and load their own
+// scale, call beam_frame() / beam_lost() after them; no bios routine the
+// game uses changes the intensity, so it is kept over frames
+
+#define BEAM_UNKNOWN 0	// scale 0 is never used
+
+struct beam_t
+{
+	unsigned int scale;
+	unsigned int intensity;
+	unsigned int zeroed;
+};
+
+extern struct beam_t beam;
+
+static inline __attribute__((always_inline))
+void beam_lost(void)
+{
+	beam.scale = BEAM_UNKNOWN;
+	beam.zeroed = 0;
+}
+
+static inline __attribute__((always_inline))
+void beam_frame(void)
+{
+	beam_lost();
+}
+
+static inline __attribute__((always_inline))
+void beam_reset(void)
+{
+	if (beam.zeroed)
+	{
+		perf_count(calls_saved);
+		return;
+	}
+	trace_Reset0Ref();
+	beam.zeroed = 1;
+}
+
+static inline __attribute__((always_inline))
+void beam_scale(unsigned int scale)
+{
+	if (beam.scale == scale)
+	{
+		perf_count(writes_saved);
+		return;
+	}
+	trace_scale(scale);
+	beam.scale = scale;
+}
+
+static inline __attribute__((always_inline))
+void beam_intensity_5F(void)
+{
+	if (beam.intensity == 0x5F)
+	{
+		perf_count(calls_saved);
+		return;
+	}
+	trace_Intensity_5F();
+	beam.intensity = 0x5F;
+}
+
+static inline __attribute__((always_inline))
+void beam_moveto(int y, int x)
+{
+	trace_Moveto_d(y, x);
+	beam.zeroed = 0;
+}
+
+// the same blank move without the bios, split so the caller can do some
+// work while the integrators run (utils/vectors.h), then beam_move_end()
+static inline __attribute__((always_inline))
+void beam_move_begin(int y, int x)
+{
+	trace_record(TRACE_MOVE, y, x);
+	move_begin(y, x);
+	beam.zeroed = 0;
+}
+
+static inline __attribute__((always_inline))
+void beam_move_end(void)
+{
+	move_end();
+}
+
+static inline __attribute__((always_inline))
+void beam_line(int y, int x)
+{
+	trace_Draw_Line_d(y, x);
+	beam.zeroed = 0;
+}
+
+static inline __attribute__((always_inline))
+void beam_list(const void* list)
+{
+	trace_Draw_VLp(list);
+	beam.zeroed = 0;
+}
+
+// sprites, count vectors of a Draw_VLp() list drawn by draw_vectors()
+static inline __attribute__((always_inline))
+void beam_vectors(const int* list, unsigned int count)
+{
+	trace_record(TRACE_LIST, (int) ((unsigned long int) list >> 8), (int) ((unsigned long int) list & 255UL));
+	draw_vectors(list, count);
+	beam.zeroed = 0;
+}
+
+static inline __attribute__((always_inline))
+void beam_dots(const void* list, unsigned int count)
+{
+	trace_Dot_List(list, count);
+	beam.zeroed = 0;
+}
+
 // ---------------------------------------------------------------------------
 // position vector beam at absolute sprite coordinates
 
@@ -19,12 +145,14 @@ void reset_beam(void)
 {
 	//Reset0Ref();
 	dp_VIA_cntl = 0xcc;	// zero the integrators
+	beam.zeroed = 1;
 }
 
 static inline __attribute__((always_inline)) 
 void scale_beam(const unsigned int scale)
 {
 	dp_VIA_t1_cnt_lo = scale;
+	beam.scale = scale;
 }
 
 static inline __attribute__((always_inline)) 
@@ -33,6 +161,7 @@ void position_beam(const int y, const int x)
 	reset_beam();
 	scale_beam(GRID_SCALE);
 	Moveto_d(y, x);
+	beam.zeroed = 0;
 }
 
 static inline __attribute__((always_inline)) 
@@ -41,6 +170,7 @@ void position_beam_yx(const long int yx)
 	reset_beam();
 	scale_beam(GRID_SCALE);
 	Moveto_dd(yx);
+	beam.zeroed = 0;
 }
 
 static inline __attribute__((always_inline)) 
@@ -49,6 +179,7 @@ void position_beam_s(const int y, const int x, const unsigned int scale)
 	reset_beam();
 	scale_beam(scale);
 	Moveto_d(y, x);
+	beam.zeroed = 0;
 }
 
 static inline __attribute__((always_inline)) 
@@ -57,65 +188,54 @@ void position_beam_yxs(const long int yx, const unsigned int scale)
 	reset_beam();
 	scale_beam(scale);
 	Moveto_dd(yx);
+	beam.zeroed = 0;
 }
 
 // ---------------------------------------------------------------------------
-
-static inline __attribute__((always_inline)) 
-void sync()
-{
-
-	// game loop header start - do not change
-	DP_to_C8();
-	Explosion_Snd(current_explosion);
-	Init_Music_chk(current_music);
-	Wait_Recal();
-	Do_Sound();
-	// game loop header end
-}
-
-void Sync();
-
-// ---------------------------------------------------------------------------
-// workaround: gcc6809 cannot handle shift by non-constant int (long int works)
+// workaround: gcc6809 cannot handle shift by non-constant int, done by
+// multiplication (arith.h), 8 bits and more shift everything out
 
 static inline __attribute__((always_inline)) 
 unsigned int shift_left(unsigned int operand, unsigned int bits)
 { 
-	return (unsigned int) ((long unsigned int) operand << (long unsigned int) bits);
+	return shl8(operand, bits);
 }
 
 static inline __attribute__((always_inline)) 
 unsigned int shift_right(unsigned int operand, unsigned int bits)
 { 
-	return (unsigned int) ((long unsigned int) operand >> (long unsigned int) bits);
+	return shr8(operand, bits);
 }
 
 static inline __attribute__((always_inline)) 
 int rotate_left(int operand, unsigned int bits)
 { 
-	return (int) ((long int) operand << (long unsigned int) bits);
+	return (int) shl8((unsigned int) operand, bits);
 }
 
 static inline __attribute__((always_inline)) 
 int roate_right(int operand, unsigned int bits)
 { 
-	return (int) ((long int) operand >> (long unsigned int) bits);
+	return asr8(operand, bits);
 }
 
 // ---------------------------------------------------------------------------
-// workaround: gcc6809 cannot handle division by non-constant int (long int works)
+// workaround: gcc6809 cannot handle division by non-constant int, 8 bit
+// shift and subtract (arith.h) instead of the 16 bit libgcc division;
+// divs() negates through unsigned int so -128 works, -128 / -1 gives -128
 
 static inline __attribute__((always_inline)) 
 unsigned int divu(unsigned int dividend, unsigned int divisor)
 { 
-	return (unsigned int) ((long unsigned int) dividend / (long unsigned int) divisor);
+	return div8(dividend, divisor);
 }
 
 static inline __attribute__((always_inline)) 
 int divs(int dividend, int divisor)
 { 
-	return (int) ((long int) dividend / (long int) divisor);
+	unsigned int quotient = div8(dividend < 0 ? 0U - (unsigned int) dividend : (unsigned int) dividend,
+		divisor < 0 ? 0U - (unsigned int) divisor : (unsigned int) divisor);
+	return (int) ((dividend < 0) != (divisor < 0) ? 0U - quotient : quotient);
 }
 
 // ***************************************************************************
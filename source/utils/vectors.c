@@ -0,0 +1,109 @@
+// ***************************************************************************
+// vectors
+// ***************************************************************************
+
+#include <vectrex.h>
+#include "utils.h"
+#include "vectors.h"
+
+// ---------------------------------------------------------------------------
+// one vector at x, the register sequence of Draw_VLp(): y to the dac, the
+// mux samples it while the pattern is loaded (9 cycles, as in the bios),
+// x to the dac, pattern to the shift register, timer 1 runs for the scale
+// loaded into its latch by beam_scale(), then the beam goes off; VIA
+// registers through the direct page ($D0): 0 port b, 1 port a, 5 timer 1
+// high, 10 shift register, 13 interrupt flags
+
+#define VECTOR(wait) \
+	"	ldd	1,x\n"		/* y, x */ \
+	"	sta	*1\n"		/* y to the dac */ \
+	"	clr	*0\n"		/* mux on, y integrator samples */ \
+	"	lda	,x\n"		/* pattern */ \
+	"	leax	3,x\n" \
+	"	inc	*0\n"		/* mux off */ \
+	"	stb	*1\n"		/* x to the dac */ \
+	"	sta	*10\n"		/* 0 = blank, $FF = lit */ \
+	"	clr	*5\n"		/* start timer 1, ramp on */ \
+	"	ldd	#64\n"		/* a = 0, b = timer 1 flag */ \
+	wait ":\n" \
+	"	bitb	*13\n" \
+	"	beq	" wait "\n" \
+	"	sta	*10\n"		/* beam off */
+
+// ---------------------------------------------------------------------------
+// draw count vectors (at least 1) from the current beam position, an odd
+// vector first, then pairs counted down in the count argument itself
+
+void draw_vectors(const int* list, unsigned int count)
+{
+	__asm__ __volatile__
+	(
+		"	ldx	%1\n"
+		"	lsr	%0\n"			/* pairs, carry = odd vector */
+		"	bcc	dv_pairs%=\n"
+		VECTOR("dv_odd%=")
+		"dv_pairs%=:\n"
+		"	tst	%0\n"
+		"	beq	dv_done%=\n"
+		"dv_loop%=:\n"
+		VECTOR("dv_first%=")
+		VECTOR("dv_second%=")
+		"	dec	%0\n"
+		"	bne	dv_loop%=\n"
+		"dv_done%=:\n"
+		: "+m" (count)
+		: "m" (list)
+		: "d", "x", "cc", "memory"
+	);
+}
+
+// ---------------------------------------------------------------------------
+// cycles per sprite in units of 16 of the bios and of draw_vectors(), each
+// measured over BENCH_DRAWS draws right after Wait_Recal() so timer 2 does
+// not expire (16 pyoros are about 8000 cycles); the integrators are held
+// at zero, nothing moves, only the time counts
+
+#if DEBUG
+
+#define BENCH_DRAWS 16	// timer 2 high byte counts 256 cycles
+
+static inline __attribute__((always_inline))
+void bench_start(unsigned int scale)
+{
+	Wait_Recal();
+	beam_frame();
+	beam_intensity_5F();
+	beam_scale(scale);
+}
+
+void bench_vectors(const int* list, unsigned int count, unsigned int scale, unsigned int slot)
+{
+	unsigned int i;
+	unsigned int start;
+	
+	bench_start(scale);
+	start = VIA_t2_hi;
+	for (i = 0; i < BENCH_DRAWS; ++i)
+	{
+		reset_beam();
+		Draw_VLp((void*) list);
+	}
+	perf.bench[slot] = start - VIA_t2_hi;
+	
+	bench_start(scale);
+	start = VIA_t2_hi;
+	for (i = 0; i < BENCH_DRAWS; ++i)
+	{
+		reset_beam();
+		draw_vectors(list, count);
+	}
+	perf.bench[slot + 1] = start - VIA_t2_hi;
+	
+	beam_lost();
+}
+
+#endif
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
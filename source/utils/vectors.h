@@ -0,0 +1,87 @@
+// ***************************************************************************
+// vectors
+// ***************************************************************************
+
+#pragma once
+#include <vectrex.h>
+#include "../config.h"
+
+// ---------------------------------------------------------------------------
+// sprite drawing without the bios
+//
+// draw_vectors() draws a list in Draw_VLp() format (pattern, y, x; 0 =
+// move, -1 = draw) with the register sequence of the bios, written in
+// inline assembly, but the caller passes the number of vectors: there is
+// no test of the pattern byte for the end of the list, the pattern goes to
+// the shift register as it is, two vectors are drawn per loop and the
+// timer 1 flag is polled in place; the direct page stays $D0 (set by
+// Wait_Recal()) for the whole sprite, no bios call saves and restores it
+//
+// cycles counted with the tools/asm6809.py table, without the timer 1
+// waits (the same polls in both): a vector is 52 cycles against 61 in
+// Draw_VLp(), a sprite adds 16 + 10 per pair in draw_vectors() and about
+// 16 for the jump to Check0Ref in the bios; vectors_pyoro_right (7
+// vectors) is 420 against 443, vectors_bean (5) is 306 against 321
+//
+// with DEBUG=1, bench_vectors() measures draw_vectors() against Draw_VLp()
+// on one sprite and leaves the cycles per sprite in perf.bench[slot] (bios)
+// and perf.bench[slot + 1]; main() runs it once at startup on the pyoro
+// and the bean sprite, see the bench_* columns of tools/perf.py
+//
+// move_begin() starts a blank move with the register sequence of
+// Moveto_d() and returns while the integrators run, move_end() waits for
+// timer 1; code between the two runs for free as long as it is shorter
+// than the move, a longer one only delays the next vector (timer 1 stops
+// the ramp through PB7 and the beam is blank)
+
+// number of vectors of a list in Draw_VLp() format
+#define VECTORS(list) ((sizeof(list) / sizeof((list)[0]) - 1) / 3)
+
+// ---------------------------------------------------------------------------
+// blank move, timer 1 runs for the scale loaded into its latch by
+// beam_scale(); Reset0Ref() leaves the integrators held at zero ($CC)
+
+static inline __attribute__((always_inline))
+void move_begin(int y, int x)
+{
+	dp_VIA_port_a = y;				// y to the dac
+	dp_VIA_port_b = 0;				// mux on, y integrator samples
+	dp_VIA_cntl = 0xCE;				// release the integrators, as Moveto_d()
+	dp_VIA_shift_reg = 0;			// blank; both writes let the mux settle
+	dp_VIA_port_b = 1;				// mux off
+	dp_VIA_port_a = x;				// x to the dac
+	dp_VIA_t1_cnt_hi = 0;			// start timer 1, ramp on
+}
+
+static inline __attribute__((always_inline))
+void move_end(void)
+{
+	while (!(dp_VIA_int_flags & 0x40))
+	{
+	}
+}
+
+// ---------------------------------------------------------------------------
+
+void draw_vectors(const int* list, unsigned int count);
+
+#if DEBUG
+
+void bench_vectors(const int* list, unsigned int count, unsigned int scale, unsigned int slot);
+
+#else
+
+static inline __attribute__((always_inline))
+void bench_vectors(const int* list, unsigned int count, unsigned int scale, unsigned int slot)
+{
+	(void) list;
+	(void) count;
+	(void) scale;
+	(void) slot;
+}
+
+#endif
+
+// ***************************************************************************
+// end of file
+// ***************************************************************************
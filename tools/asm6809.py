@@ -0,0 +1,266 @@
+# ***************************************************************************
+# asm6809 - reader for gcc6809 assembler output and 6809 cycle table
+# ***************************************************************************
+#
+# shared by the analysis tools (wcet, bench, ...); parses the .s files
+# make.bat writes to build\lib (the same text the .lst listings are made
+# of) into functions and instructions and knows the cycle count of every
+# 6809 instruction and addressing mode
+
+import glob
+import os
+import re
+
+# ---------------------------------------------------------------------------
+# cycles per addressing mode: (inherent, immediate, direct, extended, indexed)
+# indexed cycles are the base count, the post byte adds indexed_extra()
+
+_ALU8 = (None, 2, 4, 5, 4)
+_ST8 = (None, None, 4, 5, 4)
+_RMW = (None, None, 6, 7, 6)
+_LD16 = (None, 3, 5, 6, 5)
+_ST16 = (None, None, 5, 6, 5)
+_ALU16 = (None, 4, 6, 7, 6)
+_LD16P = (None, 4, 6, 7, 6)		# prefixed ldy, lds
+_ST16P = (None, None, 6, 7, 6)	# prefixed sty, sts
+_CMP16P = (None, 5, 7, 8, 7)	# prefixed cmpd, cmpy, cmpu, cmps
+
+CYCLES = {}
+
+for _m in ("adca", "adcb", "adda", "addb", "anda", "andb", "bita", "bitb",
+           "cmpa", "cmpb", "eora", "eorb", "lda", "ldb", "ora", "orb",
+           "sbca", "sbcb", "suba", "subb"):
+    CYCLES[_m] = _ALU8
+for _m in ("sta", "stb"):
+    CYCLES[_m] = _ST8
+for _m in ("neg", "com", "lsr", "ror", "asr", "asl", "lsl", "rol", "dec",
+           "inc", "tst", "clr"):
+    CYCLES[_m] = _RMW
+    CYCLES[_m + "a"] = (2, None, None, None, None)
+    CYCLES[_m + "b"] = (2, None, None, None, None)
+for _m in ("ldd", "ldx", "ldu"):
+    CYCLES[_m] = _LD16
+for _m in ("std", "stx", "stu"):
+    CYCLES[_m] = _ST16
+for _m in ("addd", "subd", "cmpx"):
+    CYCLES[_m] = _ALU16
+for _m in ("ldy", "lds"):
+    CYCLES[_m] = _LD16P
+for _m in ("sty", "sts"):
+    CYCLES[_m] = _ST16P
+for _m in ("cmpd", "cmpy", "cmpu", "cmps"):
+    CYCLES[_m] = _CMP16P
+for _m in ("leax", "leay", "leas", "leau"):
+    CYCLES[_m] = (None, None, None, None, 4)
+
+CYCLES.update({
+    "jmp": (None, None, 3, 4, 3),
+    "jsr": (None, None, 7, 8, 7),
+    "abx": (3, None, None, None, None),
+    "daa": (2, None, None, None, None),
+    "mul": (11, None, None, None, None),
+    "nop": (2, None, None, None, None),
+    "sex": (2, None, None, None, None),
+    "rts": (5, None, None, None, None),
+    "rti": (15, None, None, None, None),
+    "swi": (19, None, None, None, None),
+    "sync": (4, None, None, None, None),
+    "tfr": (6, None, None, None, None),
+    "exg": (8, None, None, None, None),
+    "andcc": (None, 3, None, None, None),
+    "orcc": (None, 3, None, None, None),
+    "cwai": (None, 20, None, None, None),
+})
+
+BRANCHES = ("bra", "brn", "bhi", "bls", "bcc", "bhs", "bcs", "blo", "bne",
+            "beq", "bvc", "bvs", "bpl", "bmi", "bge", "blt", "bgt", "ble")
+
+# register sizes for push / pull
+REGISTER_BYTES = {"cc": 1, "a": 1, "b": 1, "dp": 1, "d": 2, "x": 2, "y": 2,
+                  "u": 2, "s": 2, "pc": 2}
+
+# ---------------------------------------------------------------------------
+
+
+def indexed_extra(operand):
+    indirect = operand.startswith("[")
+    body = operand.strip("[]")
+    extra = 3 if indirect else 0
+    if "," not in body:
+        return 5 if indirect else 0		# [address]
+    offset, register = body.split(",", 1)
+    offset = offset.strip()
+    register = register.strip().lower()
+    if register.endswith("++") or register.startswith("--"):
+        return extra + 3
+    if register.endswith("+") or register.startswith("-"):
+        return extra + 2
+    if offset == "":
+        return extra
+    if offset.lower() in ("a", "b"):
+        return extra + 1
+    if offset.lower() == "d":
+        return extra + 4
+    try:
+        value = int(offset, 0)
+    except ValueError:
+        return extra + 4				# symbolic offset, assume 16 bit
+    if -128 <= value <= 127:
+        return extra + 1
+    return extra + 4
+
+
+def register_list_bytes(operand):
+    return sum(REGISTER_BYTES.get(r.strip().lower(), 0) for r in operand.split(","))
+
+
+def mode(operand):
+    if operand == "":
+        return 0
+    if operand.startswith("#"):
+        return 1
+    if operand.startswith("<") or operand.startswith("*"):
+        return 2
+    if "," in operand or operand.startswith("["):
+        return 4
+    return 3
+
+# ---------------------------------------------------------------------------
+
+
+class Instruction:
+    def __init__(self, mnemonic, operand, text, line):
+        self.mnemonic = mnemonic
+        self.operand = operand
+        self.text = text
+        self.line = line
+        self.cycles = cycles(mnemonic, operand)
+
+    def branch(self):
+        # returns (target, conditional) for branches, None otherwise
+        name = self.mnemonic[1:] if self.mnemonic.startswith("lb") else self.mnemonic
+        if name in BRANCHES:
+            return self.operand, name not in ("bra",)
+        return None
+
+    def call(self):
+        # jsr / bsr, and jmp into another function (tail call) or through
+        # a pointer; a jmp is a call and a return at the same time
+        if self.mnemonic in ("jsr", "bsr", "lbsr"):
+            return self.operand.lstrip("<>*")
+        if self.mnemonic == "jmp" and (self.indirect() or self.operand.lstrip("<>*").startswith("_")):
+            return self.operand.lstrip("<>*")
+        return None
+
+    def indirect(self):
+        # call through a register or a pointer in memory, e.g. jsr [2,x]
+        return "," in self.operand or self.operand.startswith("[")
+
+    def returns(self):
+        if self.mnemonic in ("rts", "rti"):
+            return True
+        if self.mnemonic in ("puls", "pulu") and "pc" in self.operand.lower().split(","):
+            return True
+        return self.mnemonic == "jmp"
+
+
+def cycles(mnemonic, operand):
+    if mnemonic in ("pshs", "puls", "pshu", "pulu"):
+        return 5 + register_list_bytes(operand)
+    if mnemonic == "bsr":
+        return 7
+    if mnemonic == "lbsr":
+        return 9
+    if mnemonic.startswith("lb"):
+        return 6 if mnemonic != "lbra" else 5		# taken long branch
+    if mnemonic.startswith("b") and mnemonic[1:] and (mnemonic in BRANCHES):
+        return 3
+    table = CYCLES.get(mnemonic)
+    if table is None:
+        raise ValueError("unknown instruction '%s'" % mnemonic)
+    m = mode(operand)
+    base = table[m]
+    if base is None:
+        raise ValueError("bad addressing mode for '%s %s'" % (mnemonic, operand))
+    if m == 4:
+        base += indexed_extra(operand)
+    return base
+
+# ---------------------------------------------------------------------------
+
+
+class Function:
+    def __init__(self, name, module):
+        self.name = name
+        self.module = module
+        self.items = []		# ("label", name) or ("insn", Instruction)
+
+    def instructions(self):
+        return [i for k, i in self.items if k == "insn"]
+
+    def taken_labels(self):
+        # labels whose address is loaded (gnu c &&label), the targets of a
+        # computed goto (jmp through a register) in this function
+        labels = {item for kind, item in self.items if kind == "label"}
+        taken = set()
+        for insn in self.instructions():
+            if insn.branch() is None:
+                for word in re.findall(r"[A-Za-z_.$][\w.$]*", insn.operand):
+                    if word in labels:
+                        taken.add(word)
+        return taken
+
+
+_DATA = (".byte", ".db", ".fcb", ".word", ".dw", ".fdb", ".ascii", ".asciz",
+         ".str", ".fcc", ".blkb", ".blkw", ".ds", ".rmb")
+
+_LABEL = re.compile(r"^([A-Za-z_.$][\w.$]*):(.*)$")
+
+
+def read_module(path):
+    module = os.path.splitext(os.path.basename(path))[0]
+    functions = []
+    current = None
+    pending = []
+    for number, raw in enumerate(open(path, encoding="latin-1"), 1):
+        line = raw.split(";", 1)[0].rstrip()
+        if not line.strip():
+            continue
+        match = _LABEL.match(line)
+        if match:
+            pending.append(match.group(1))
+            line = match.group(2)
+            if not line.strip():
+                continue
+        fields = line.split(None, 1)
+        word = fields[0].lower()
+        operand = fields[1].strip() if len(fields) > 1 else ""
+        if word.startswith("."):
+            if word in _DATA:
+                # labelled data ends the current function
+                current = None
+                pending = []
+            continue
+        for label in pending:
+            if label.startswith("_") and (current is None or label != current.name):
+                current = Function(label[1:], module)
+                functions.append(current)
+            elif current is not None:
+                current.items.append(("label", label))
+        pending = []
+        if current is None:
+            continue
+        current.items.append(("insn", Instruction(word, operand, raw.rstrip(), number)))
+    return functions
+
+
+def read_build(folder):
+    functions = {}
+    for path in sorted(glob.glob(os.path.join(folder, "*.s"))):
+        for function in read_module(path):
+            functions[function.name] = function
+    return functions
+
+# ***************************************************************************
+# end of file
+# ***************************************************************************
@@ -0,0 +1,117 @@
+# ***************************************************************************
+# bench - optimization level matrix for the cartridge build
+# ***************************************************************************
+#
+# builds the cartridge once per flag profile (with and without the rxrepl
+# peephole pass), keeps the output of every build in build\bench\PROFILE
+# and tabulates rom size, ram size, the static worst case frame and the
+# worst case cycles of every function (see wcet.py)
+#
+# usage (from the project folder, normally through make.bat bench):
+#   python tools\bench.py [--profile NAME FLAGS]... [--functions]
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+
+import asm6809
+import wcet
+
+TOOLS = os.path.dirname(os.path.abspath(__file__))
+
+PROFILES = [
+    ("O0", "-O0"),
+    ("O1", "-O1"),
+    ("O2", "-O2"),
+    ("Os", "-Os"),
+    ("O2gcse", "-O2 -fgcse-sm -fgcse-las -fgcse-after-reload"),
+]
+
+# ---------------------------------------------------------------------------
+
+
+def size(path):
+    return os.path.getsize(path) if os.path.exists(path) else 0
+
+
+def build(project, flags, peephole, folder):
+    environment = dict(os.environ, PEEPHOLE="1" if peephole else "0")
+    result = subprocess.run(["cmd", "/c", "make.bat", "build", flags], env=environment,
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+    if os.path.exists(folder):
+        shutil.rmtree(folder)
+    os.makedirs(folder)
+    with open(os.path.join(folder, "build.log"), "w") as log:
+        log.write(result.stdout)
+    rom = os.path.join("build", project + "_rom.bin")
+    ram = os.path.join("build", project + "_ram.bin")
+    if result.returncode != 0 or not os.path.exists(rom):
+        return None
+    for name in os.listdir(os.path.join("build", "lib")):
+        shutil.copy(os.path.join("build", "lib", name), folder)
+    for name in (rom, ram, os.path.join("build", project + ".map")):
+        if os.path.exists(name):
+            shutil.copy(name, folder)
+    return size(rom), size(ram)
+
+
+def measure(folder, bounds):
+    analysis = wcet.Analysis(asm6809.read_build(folder), bounds)
+    cycles = {name: analysis.function(name) for name in analysis.functions}
+    return cycles, bool(analysis.errors)
+
+# ---------------------------------------------------------------------------
+
+
+def main():
+    parser = argparse.ArgumentParser(description="optimization level matrix")
+    parser.add_argument("--profile", nargs=2, action="append", metavar=("NAME", "FLAGS"),
+                        help="replace the default profiles")
+    parser.add_argument("--entry", default="game_frame")
+    parser.add_argument("--functions", action="store_true",
+                        help="also list the worst case cycles per function")
+    args = parser.parse_args()
+
+    project = os.path.basename(os.getcwd())
+    bounds = wcet.Bounds(os.path.join(TOOLS, "wcet.txt"))
+    results = []
+    for name, flags in args.profile or PROFILES:
+        for peephole in (False, True):
+            label = name + ("+rx" if peephole else "")
+            print("building %-10s %s" % (label, flags))
+            sizes = build(project, flags, peephole, os.path.join("build", "bench", label))
+            if sizes is None:
+                results.append((label, None, None, None, {}))
+                continue
+            cycles, unbounded = measure(os.path.join("build", "bench", label), bounds)
+            frame = cycles.get(args.entry)
+            results.append((label, sizes[0], sizes[1],
+                            "%d%s" % (frame, "?" if unbounded else "") if frame else "-", cycles))
+
+    print()
+    print("%-10s %8s %8s %10s" % ("profile", "rom", "ram", args.entry))
+    for label, rom, ram, frame, _ in results:
+        if rom is None:
+            print("%-10s %8s" % (label, "failed"))
+        else:
+            print("%-10s %8d %8d %10s" % (label, rom, ram, frame))
+
+    if args.functions:
+        names = sorted(set().union(*(r[4] for r in results)))
+        print()
+        print("%-20s" % "function" + "".join("%10s" % r[0] for r in results))
+        for function in names:
+            print("%-20s" % function[:20] + "".join(
+                "%10s" % r[4].get(function, "-") for r in results))
+    return 0 if all(r[1] is not None for r in results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+
+# ***************************************************************************
+# end of file
+# ***************************************************************************
@@ -0,0 +1,153 @@
+# ***************************************************************************
+# footprint - rom / ram usage per symbol with budgets
+# ***************************************************************************
+#
+# lists every global function and variable of the linked cartridge with
+# its size and area, sums them per module, shows how much of the 1 KB ram
+# is left for the stack and the change against a checked in baseline;
+# the retained block at $CB00-$CB0F (source/retain.h) is neither statics
+# nor stack, statics must end below it and the stack must stay above it
+#
+# budgets are read from tools\footprint.txt, the build fails if a module
+# or the total is over budget or the stack room falls below the minimum
+#
+# usage:
+#   python tools\footprint.py [--map build\game_own.map] [--symbols]
+#   python tools\footprint.py --update-baseline     (after a reviewed change)
+
+import argparse
+import os
+import sys
+
+import mapfile
+
+TOOLS = os.path.dirname(os.path.abspath(__file__))
+
+# ---------------------------------------------------------------------------
+# budget file
+#   stack BYTES            minimum ram left between statics and bios stack top
+#   MODULE ROM RAM         budget of a module in bytes, * = whole cartridge
+
+
+def read_budgets(path):
+    stack = 0
+    modules = {}
+    for number, line in enumerate(open(path), 1):
+        fields = line.split("#", 1)[0].split()
+        if not fields:
+            continue
+        if fields[0] == "stack" and len(fields) == 2:
+            stack = int(fields[1])
+        elif len(fields) == 3:
+            modules[fields[0]] = (int(fields[1]), int(fields[2]))
+        else:
+            raise SystemExit("%s:%d: bad budget line" % (path, number))
+    return stack, modules
+
+
+def read_baseline(path):
+    baseline = {}
+    if os.path.exists(path):
+        for line in open(path):
+            fields = line.split()
+            if len(fields) == 4:
+                baseline[(fields[0], fields[1])] = int(fields[3])
+    return baseline
+
+
+def write_baseline(path, table):
+    with open(path, "w") as out:
+        for symbol in sorted(table, key=lambda s: (s.module, s.name)):
+            out.write("%s %s %s %d\n" % (symbol.module, symbol.name, symbol.area.name, symbol.size))
+
+# ---------------------------------------------------------------------------
+
+
+def delta(now, before):
+    if before is None:
+        return "new"
+    return "%+d" % (now - before) if now != before else ""
+
+
+def main():
+    parser = argparse.ArgumentParser(description="rom / ram footprint")
+    parser.add_argument("--map", default=os.path.join(
+        "build", os.path.basename(os.getcwd()) + ".map"))
+    parser.add_argument("--budget", default=os.path.join(TOOLS, "footprint.txt"))
+    parser.add_argument("--baseline", default=os.path.join(TOOLS, "footprint_baseline.txt"))
+    parser.add_argument("--update-baseline", action="store_true")
+    parser.add_argument("--symbols", action="store_true", help="list every symbol")
+    args = parser.parse_args()
+
+    areas = mapfile.read(args.map)
+    table = mapfile.symbols(areas)
+    if args.update_baseline:
+        write_baseline(args.baseline, table)
+        print("baseline written to %s" % args.baseline)
+        return 0
+    baseline = read_baseline(args.baseline)
+    stack, budgets = read_budgets(args.budget)
+
+    if args.symbols:
+        print("%-24s %-12s %-10s %6s %6s" % ("symbol", "module", "area", "size", "delta"))
+        for symbol in sorted(table, key=lambda s: (s.area.name, -s.size)):
+            print("%-24s %-12s %-10s %6d %6s" % (
+                symbol.name[:24], symbol.module, symbol.area.name, symbol.size,
+                delta(symbol.size, baseline.get((symbol.module, symbol.name)))))
+        gone = set(baseline) - {(s.module, s.name) for s in table}
+        for module, name in sorted(gone):
+            print("%-24s %-12s %-10s %6s %6s" % (name[:24], module, "", "", "gone"))
+        print()
+
+    modules = {}
+    for symbol in table:
+        rom, ram, before = modules.get(symbol.module, (0, 0, 0))
+        if symbol.area.ram():
+            ram += symbol.size
+        else:
+            rom += symbol.size
+        before += baseline.get((symbol.module, symbol.name), 0)
+        modules[symbol.module] = (rom, ram, before)
+    modules["*"] = (sum(a.size for a in areas if not a.ram()),
+                    sum(a.size for a in areas if a.ram()),
+                    sum(baseline.values()))
+
+    failed = False
+    print("%-12s %6s %6s %6s %6s %8s" % ("module", "rom", "budget", "ram", "budget", "delta"))
+    for module in sorted(modules):
+        rom, ram, before = modules[module]
+        rom_budget, ram_budget = budgets.get(module, (None, None))
+        over = (rom_budget is not None and rom > rom_budget) or \
+               (ram_budget is not None and ram > ram_budget)
+        failed = failed or over
+        print("%-12s %6d %6s %6d %6s %8s%s" % (
+            module, rom, rom_budget if rom_budget is not None else "-",
+            ram, ram_budget if ram_budget is not None else "-",
+            delta(rom + ram, before) if baseline else "",
+            "  OVER BUDGET" if over else ""))
+
+    end = mapfile.ram_end(areas)
+    room = mapfile.RAM_STACK - mapfile.RETAIN_END
+    print()
+    print("ram %04X-%04X statics, %d bytes left below the retained block"
+          % (mapfile.RAM_GAME, end, mapfile.RETAIN_START - end))
+    print("ram %04X-%04X retained, %d bytes left for the stack (minimum %d)"
+          % (mapfile.RETAIN_START, mapfile.RETAIN_END, room, stack))
+    if end > mapfile.RETAIN_START:
+        print("error: statics overlap the retained block by %d bytes"
+              % (end - mapfile.RETAIN_START))
+        failed = True
+    if not baseline:
+        print("no baseline, run with --update-baseline to record one")
+    if room < stack:
+        print("error: stack room below minimum by %d bytes" % (stack - room))
+        failed = True
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+
+# ***************************************************************************
+# end of file
+# ***************************************************************************
@@ -0,0 +1,89 @@
+# ***************************************************************************
+# mapfile - reader for aslink map files
+# ***************************************************************************
+#
+# shared by the analysis tools (footprint, stack, ...); reads the areas and
+# global symbols of the map aslink writes with -m, symbol sizes are the
+# distance to the next symbol (or the end of the area)
+
+import re
+
+# vectrex memory map
+ROM_END = 0x8000
+RAM_START = 0xC800
+RAM_GAME = 0xC880		# bios variables below
+RETAIN_START = 0xCB00	# block kept over a warm reset (source/retain.h)
+RETAIN_END = 0xCB10
+RAM_STACK = 0xCBEA		# initial stack pointer set by the bios
+RAM_END = 0xCC00
+
+_AREA = re.compile(r"^\s*(\S+)\s+([0-9A-Fa-f]{4,})\s+([0-9A-Fa-f]{4,})\s*=\s*(\d+)\.\s*bytes")
+_SYMBOL = re.compile(r"^\s*(?:[0-9A-Fa-f]{2}:)?([0-9A-Fa-f]{4,})\s+([A-Za-z_.$][\w.$]*)(?:\s+(\S+))?\s*$")
+
+# ---------------------------------------------------------------------------
+
+
+class Area:
+    def __init__(self, name, address, size):
+        self.name = name
+        self.address = address
+        self.size = size
+        self.symbols = []
+
+    def ram(self):
+        return RAM_START <= self.address < RAM_END
+
+    def end(self):
+        return self.address + self.size
+
+
+class Symbol:
+    def __init__(self, name, address, module, area):
+        self.name = name
+        self.address = address
+        self.module = module
+        self.area = area
+        self.size = 0
+
+
+def read(path):
+    areas = []
+    current = None
+    for line in open(path, encoding="latin-1"):
+        match = _AREA.match(line)
+        if match:
+            current = Area(match.group(1), int(match.group(2), 16), int(match.group(3), 16))
+            areas.append(current)
+            continue
+        match = _SYMBOL.match(line)
+        if match and current is not None:
+            name = match.group(2)
+            module = match.group(3) or "?"
+            current.symbols.append(Symbol(name[1:] if name.startswith("_") else name,
+                                          int(match.group(1), 16), module, current))
+    for area in areas:
+        area.symbols.sort(key=lambda s: s.address)
+        for symbol, following in zip(area.symbols, area.symbols[1:] + [None]):
+            end = following.address if following else area.end()
+            symbol.size = max(0, end - symbol.address)
+    return [a for a in areas if a.size > 0 or a.symbols]
+
+
+def symbols(areas):
+    return [s for a in areas for s in a.symbols]
+
+
+def find(areas, name):
+    for symbol in symbols(areas):
+        if symbol.name == name:
+            return symbol
+    return None
+
+
+def ram_end(areas):
+    # first free byte above all static ram data
+    return max([a.end() for a in areas if a.ram()] + [RAM_GAME])
+
+# ***************************************************************************
+# end of file
+# ***************************************************************************
@@ -0,0 +1,99 @@
+# ***************************************************************************
+# perf - performance counter block of DEBUG=1 builds
+# ***************************************************************************
+#
+# the harness copies the counter block (layout see source/utils/perf.h)
+# each time Wait_Recal() is entered and appends the copies to a binary
+# file; this tool prints where the block lives and converts such a file
+# to csv, one line per frame, cycles converted from units of 256
+#
+# boot_frames is the number of frames from reset to the first gameplay
+# frame (Vec_Loop_Count, 0 until then), boot_cycles the same at the bios
+# refresh period of 30000 cycles; compare a warm reset of FAST_BOOT=0 and
+# =1 builds
+#
+# refresh is the refresh period level of the frame (0 = 25000 cycles, 60 Hz,
+# 1 = 27500, 2 = 30000, 3 = 33750), rate_changes counts its changes
+#
+# sound is the audio tick right after Wait_Recal() (source/utils/sound.h),
+# at most one effect starts per frame so it stays flat when events pile up
+#
+# players splits a run into one and two player frames, compare the update
+# column of both to see the cost of the second player
+#
+# writes_saved / calls_saved are the scale writes and bios calls (reset,
+# intensity) the beam state layer skipped in that frame
+#
+# bench_* are the cycles of one pyoro / bean sprite drawn by the bios
+# (Draw_VLp) and by draw_vectors(), measured once at startup
+#
+# slices is the number of bean moves and spawn plans done ahead while the
+# beam moved (source/bean.h); that work is gone from the update column, the
+# update cycles saved per slice over the cycles of one bean in the draw
+# column give the beans gained per frame
+#
+# usage:
+#   python tools\perf.py address build\game_own.map
+#   python tools\perf.py csv DUMP [DUMP ...] > frames.csv
+
+import argparse
+import sys
+
+import mapfile
+
+MAGIC = b"PF"
+SIZE = 29
+BIOS_FRAME = 30000  # cycles, Vec_Rfrsh after reset
+
+COLUMNS = ("frame", "left", "worst", "overruns", "input", "update", "draw",
+           "sound", "spawned", "destroyed", "psg_writes", "boot_frames",
+           "boot_cycles",
+           "writes_saved", "calls_saved", "players", "refresh", "rate_changes",
+           "bench_pyoro_bios", "bench_pyoro", "bench_bean_bios", "bench_bean",
+           "slices")
+
+# ---------------------------------------------------------------------------
+
+
+def records(path):
+    data = open(path, "rb").read()
+    for offset in range(0, len(data) - SIZE + 1, SIZE):
+        block = data[offset:offset + SIZE]
+        if block[0:2] != MAGIC:
+            raise SystemExit("%s: bad magic at offset %d" % (path, offset))
+        yield ((block[2] << 8) | block[3],
+               block[4] * 256, block[5] * 256, block[8],
+               block[9] * 256, block[10] * 256, block[11] * 256, block[12] * 256,
+               block[13], block[14], block[15], (block[17] << 8) | block[18],
+               ((block[17] << 8) | block[18]) * BIOS_FRAME,
+               block[19], block[20], block[21], block[22], block[23],
+               block[24] * 16, block[25] * 16, block[26] * 16, block[27] * 16,
+               block[28])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="performance counter block")
+    parser.add_argument("command", choices=["address", "csv"])
+    parser.add_argument("files", nargs="+")
+    args = parser.parse_args()
+
+    if args.command == "address":
+        symbol = mapfile.find(mapfile.read(args.files[0]), "perf")
+        if symbol is None:
+            raise SystemExit("no counter block in %s, build with DEBUG=1" % args.files[0])
+        print("%04X %d" % (symbol.address, SIZE))
+        return 0
+
+    print(",".join(COLUMNS))
+    for path in args.files:
+        for record in records(path):
+            print(",".join(str(value) for value in record))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+
+# ***************************************************************************
+# end of file
+# ***************************************************************************
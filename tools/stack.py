@@ -0,0 +1,199 @@
+# ***************************************************************************
+# stack - static worst case stack depth
+# ***************************************************************************
+#
+# follows the stack adjustments (pshs / puls, leas n,s) and calls of the
+# compiled .s files in build\lib through the call graph and reports the
+# deepest stack use of every entry point; bios and library routines take
+# their stack use from tools\wcet.txt
+#
+# the stack starts at $CBEA and grows down towards the block retained over
+# a warm reset ($CB00-$CB0F, source/retain.h) and the static data below it,
+# the build fails if the deepest stack would reach either
+#
+# usage:
+#   python tools\stack.py [--build build\lib] [--map build\game_own.map]
+#                         [--entry main] [--entry game_frame] ...
+
+import argparse
+import os
+import sys
+
+import asm6809
+import mapfile
+import wcet
+
+TOOLS = os.path.dirname(os.path.abspath(__file__))
+
+# the whole program, one frame and every state's update and draw (the
+# state table in main.c), so a deep state shows up under its own name
+ENTRIES = ["main", "game_frame",
+           "title_update", "play_update", "pause_update", "game_over_update", "attract_update",
+           "title_draw", "play_draw", "pause_draw", "game_over_draw", "attract_draw"]
+
+# ---------------------------------------------------------------------------
+
+
+def adjustment(insn):
+    # stack bytes added by a single instruction
+    if insn.mnemonic == "pshs":
+        return asm6809.register_list_bytes(insn.operand)
+    if insn.mnemonic == "puls":
+        return -asm6809.register_list_bytes(insn.operand)
+    if insn.mnemonic == "leas":
+        offset, _, register = insn.operand.partition(",")
+        if register.strip().lower() == "s":
+            try:
+                return -int(offset or "0", 0)
+            except ValueError:
+                return None
+        return None
+    return 0
+
+
+class Analysis:
+    def __init__(self, functions, bounds):
+        self.functions = functions
+        self.bounds = bounds
+        self.depth = {}
+        self.path = {}
+        self.resume = {}
+        self.active = set()
+        self.errors = []
+
+    def callee(self, target, caller):
+        if asm6809.Instruction("jsr", target, "", 0).indirect():
+            targets = self.bounds.indirect.get(caller)
+            if not targets:
+                self.errors.append("no targets for call through '%s' in '%s'" % (target, caller))
+                return 0, []
+            return max((self.callee(t, caller) for t in targets), key=lambda c: c[0])
+        name = target[1:] if target.startswith("_") else target
+        if name in self.functions:
+            return self.function(name), [name]
+        use = self.bounds.stack_use(target)
+        if use is None:
+            self.errors.append("no stack bound for call to '%s'" % target)
+            return 0, []
+        return use, [target.lstrip("_")]
+
+    def function(self, name):
+        if name in self.depth:
+            return self.depth[name]
+        if name in self.active:
+            self.errors.append("recursion through '%s'" % name)
+            return 0
+        self.active.add(name)
+        code = []
+        labels = {}
+        for kind, item in self.functions[name].items:
+            if kind == "label":
+                labels[item] = len(code)
+            else:
+                code.append(item)
+        if name in self.bounds.tasks:
+            self.resume[name] = [labels[l] for l in self.functions[name].taken_labels()]
+
+        # depth at every instruction, repeated until no level changes since
+        # gcc enters rotated loops from below; a loop that does not leave
+        # the stack balanced never settles
+        level = {0: 0}
+        deepest = (0, [])
+        for _ in range(len(code) + 1):
+            before = dict(level)
+            deepest = self.walk(name, code, labels, level, deepest)
+            if level == before:
+                break
+        else:
+            self.errors.append("'%s': stack grows in a loop" % name)
+
+        self.active.discard(name)
+        self.depth[name] = deepest[0]
+        self.path[name] = deepest[1]
+        return deepest[0]
+
+    def walk(self, name, code, labels, level, deepest):
+        for index, insn in enumerate(code):
+            if index not in level:
+                continue
+            here = level[index]
+            if insn.mnemonic == "jmp" and insn.indirect() and name in self.resume:
+                # computed goto of a task, continues at any resume point
+                for successor in self.resume[name]:
+                    level[successor] = max(level.get(successor, here), here)
+                continue
+            change = adjustment(insn)
+            if change is None:
+                self.errors.append("'%s' line %d: cannot follow '%s'"
+                                   % (name, insn.line, insn.text.strip()))
+                change = 0
+            target = insn.call()
+            if target is not None:
+                use, calls = self.callee(target, name)
+                # a tail call (jmp) pushes no return address
+                use += 0 if insn.mnemonic == "jmp" else 2
+                if here + use > deepest[0]:
+                    deepest = (here + use, calls)
+            here += change
+            if here > deepest[0]:
+                deepest = (here, [])
+            successors = []
+            branch = insn.branch()
+            if branch:
+                if branch[0] in labels:
+                    successors.append(labels[branch[0]])
+                if branch[1]:
+                    successors.append(index + 1)
+            elif not insn.returns():
+                successors.append(index + 1)
+            for successor in successors:
+                level[successor] = max(level.get(successor, here), here)
+        return deepest
+
+# ---------------------------------------------------------------------------
+
+
+def main():
+    parser = argparse.ArgumentParser(description="static worst case stack depth")
+    parser.add_argument("--build", default=os.path.join("build", "lib"))
+    parser.add_argument("--map", default=os.path.join(
+        "build", os.path.basename(os.getcwd()) + ".map"))
+    parser.add_argument("--bounds", default=os.path.join(TOOLS, "wcet.txt"))
+    parser.add_argument("--entry", action="append", help="entry points, default: %s"
+                        % ", ".join(ENTRIES))
+    args = parser.parse_args()
+
+    analysis = Analysis(asm6809.read_build(args.build), wcet.Bounds(args.bounds))
+    deepest = 0
+    print("%-16s %6s  %s" % ("entry", "bytes", "deepest call chain"))
+    for entry in args.entry or ENTRIES:
+        if entry not in analysis.functions:
+            analysis.errors.append("entry '%s' not found" % entry)
+            continue
+        # + 2 for the return address of the call into the entry point
+        depth = analysis.function(entry) + 2
+        chain = [entry]
+        while chain[-1] in analysis.path and analysis.path[chain[-1]]:
+            chain.append(analysis.path[chain[-1]][-1])
+        print("%-16s %6d  %s" % (entry, depth, " > ".join(chain)))
+        deepest = max(deepest, depth)
+
+    end = max(mapfile.ram_end(mapfile.read(args.map)), mapfile.RETAIN_END)
+    bottom = mapfile.RAM_STACK - deepest
+    print()
+    print("statics / retained block end at %04X, stack reaches down to %04X, %d bytes to spare"
+          % (end, bottom, bottom - end))
+    for error in sorted(set(analysis.errors)):
+        print("error: %s" % error)
+    if bottom < end:
+        print("error: stack overlaps the static data by %d bytes" % (end - bottom))
+        return 1
+    return 1 if analysis.errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+
+# ***************************************************************************
+# end of file
+# ***************************************************************************
@@ -0,0 +1,289 @@
+# ***************************************************************************
+# trace - beam trace analyser
+# ***************************************************************************
+#
+# reads the binary trace written by the harness from a TRACE=1 build
+# (layout see source/utils/trace.h) and reports per frame:
+#
+#   lit      length of all lit strokes (vector units, value * scale)
+#   blank    length of all blank moves (vector units)
+#   resets   number of integrator resets
+#   strokes  number of lit strokes / blank moves
+#   overdraw length of lit strokes drawn more than once in the same frame
+#
+# vector lists (Draw_VLp) are expanded from the rom image, so pass the
+# cartridge binary the trace was recorded with
+#
+# usage:
+#   python tools\trace.py report  TRACE  --rom bin\game_own.bin
+#   python tools\trace.py compare GOLDEN TRACE --rom bin\game_own.bin
+#   python tools\trace.py latency TRACE --map build\game_own.map
+#
+# latency lists every shot press and change of walking direction in the
+# recorded input and the number of frames until the tongue or the turned
+# sprite is drawn (0 = drawn in the frame the input was sampled); the
+# harness injects the input, the trace records when it was sampled
+#
+# compare exits with 1 if any frame of TRACE differs from the golden trace,
+# golden traces are recorded once from a known good build and checked in
+# as tools\golden\*.trc
+
+import argparse
+import math
+import sys
+
+MAGIC = b"TR"
+
+RESET = 0
+MOVE = 1
+LINE = 2
+LIST = 3
+SCALE = 4
+INTENSITY = 5
+INPUT = 6
+DOTS = 7
+
+INPUT_LEFT = 0x01
+INPUT_RIGHT = 0x02
+INPUT_SHOOT = 0x04
+
+# frames after which an input counts as lost
+LOST = 10
+
+# ---------------------------------------------------------------------------
+
+
+def signed(value):
+    return value - 256 if value > 127 else value
+
+
+def read_frames(path):
+    data = open(path, "rb").read()
+    frames = []
+    pos = 0
+    while pos + 6 <= len(data):
+        if data[pos:pos + 2] != MAGIC:
+            raise SystemExit("%s: bad frame header at offset %d" % (path, pos))
+        number = (data[pos + 2] << 8) | data[pos + 3]
+        count = data[pos + 4]
+        overflow = data[pos + 5]
+        pos += 6
+        records = []
+        for _ in range(count):
+            op, y, x = data[pos], data[pos + 1], data[pos + 2]
+            records.append((op, y, x))
+            pos += 3
+        frames.append((number, overflow, records))
+    return frames
+
+
+def vector_list(rom, address):
+    # Draw_VLp format: pattern, y, x; pattern 0 = move, <0 = draw, >0 = end
+    vectors = []
+    while True:
+        pattern = signed(rom[address])
+        if pattern > 0:
+            return vectors
+        vectors.append((pattern < 0, signed(rom[address + 1]), signed(rom[address + 2])))
+        address += 3
+
+# ---------------------------------------------------------------------------
+
+
+class Frame:
+    def __init__(self, number, overflow):
+        self.number = number
+        self.overflow = overflow
+        self.lit = 0.0
+        self.blank = 0.0
+        self.resets = 0
+        self.strokes = 0
+        self.moves = 0
+        self.overdraw = 0.0
+        self.signature = []
+
+    def columns(self):
+        return (self.number, round(self.lit), round(self.blank), self.resets,
+                self.strokes, self.moves, round(self.overdraw), self.overflow)
+
+
+def analyse(number, overflow, records, rom):
+    frame = Frame(number, overflow)
+    scale = 0
+    y = x = 0
+    seen = set()
+
+    def segment(lit, dy, dx):
+        nonlocal y, x
+        length = math.hypot(dy * scale, dx * scale)
+        start = (y, x)
+        y += dy * scale
+        x += dx * scale
+        if lit:
+            frame.lit += length
+            frame.strokes += 1
+            key = tuple(sorted((start, (y, x))))
+            if key in seen:
+                frame.overdraw += length
+            seen.add(key)
+        else:
+            frame.blank += length
+            frame.moves += 1
+
+    for op, a, b in records:
+        frame.signature.append((op, a, b))
+        if op == RESET:
+            frame.resets += 1
+            y = x = 0
+        elif op == MOVE:
+            segment(False, signed(a), signed(b))
+        elif op == LINE:
+            segment(True, signed(a), signed(b))
+        elif op == LIST:
+            if rom is None:
+                raise SystemExit("vector list in trace, pass --rom")
+            for lit, dy, dx in vector_list(rom, (a << 8) | b):
+                segment(lit, dy, dx)
+        elif op == SCALE:
+            scale = a
+        elif op in (INTENSITY, INPUT, DOTS):
+            pass
+        else:
+            raise SystemExit("frame %d: unknown trace operation %d" % (number, op))
+    return frame
+
+
+def load(path, rom):
+    return [analyse(n, o, r, rom) for n, o, r in read_frames(path)]
+
+# ---------------------------------------------------------------------------
+
+HEADER = "%6s %8s %8s %6s %7s %6s %8s %4s" % (
+    "frame", "lit", "blank", "resets", "strokes", "moves", "overdraw", "lost")
+
+
+def report(frames):
+    print(HEADER)
+    for frame in frames:
+        print("%6d %8d %8d %6d %7d %6d %8d %4d" % frame.columns())
+    if frames:
+        count = len(frames)
+        print("-" * len(HEADER))
+        print("%6s %8d %8d %6.1f %7.1f %6.1f %8d" % (
+            "avg",
+            sum(f.lit for f in frames) / count,
+            sum(f.blank for f in frames) / count,
+            sum(f.resets for f in frames) / count,
+            sum(f.strokes for f in frames) / count,
+            sum(f.moves for f in frames) / count,
+            sum(f.overdraw for f in frames) / count))
+
+
+def compare(golden, frames):
+    if len(golden) != len(frames):
+        print("frame count differs: golden %d, trace %d" % (len(golden), len(frames)))
+        return 1
+    for old, new in zip(golden, frames):
+        if old.signature != new.signature:
+            print("first difference in frame %d" % new.number)
+            print(HEADER)
+            print("%6d %8d %8d %6d %7d %6d %8d %4d  golden" % old.columns())
+            print("%6d %8d %8d %6d %7d %6d %8d %4d  trace" % new.columns())
+            return 1
+    print("%d frames identical" % len(frames))
+    return 0
+
+
+def symbols(path, names):
+    found = {}
+    for line in open(path, encoding="latin-1"):
+        fields = line.split()
+        for index, field in enumerate(fields[1:], 1):
+            if field.lstrip("_") in names:
+                try:
+                    found[field.lstrip("_")] = int(fields[index - 1], 16)
+                except ValueError:
+                    pass
+    missing = set(names) - set(found)
+    if missing:
+        raise SystemExit("%s: symbols not found: %s" % (path, ", ".join(sorted(missing))))
+    return found
+
+
+def latency(path, sprites):
+    # per frame: sampled input, tongue drawn, facing of the drawn sprite
+    frames = []
+    for number, _, records in read_frames(path):
+        sampled = tongue = facing = None
+        for op, a, b in records:
+            if op == INPUT:
+                sampled = a
+            elif op == LINE and a == 127 and b in (127, 129):
+                tongue = True
+            elif op == LIST and ((a << 8) | b) in sprites:
+                facing = sprites[(a << 8) | b]
+        frames.append((number, sampled, tongue, facing))
+
+    events = []
+    previous = 0
+    for index, (number, sampled, _, facing) in enumerate(frames):
+        if sampled is None:
+            continue
+        pressed = sampled & ~previous
+        previous = sampled
+        wanted = []
+        if pressed & INPUT_SHOOT:
+            wanted.append(("shoot", lambda f: f[2]))
+        for bit, side in ((INPUT_LEFT, "left"), (INPUT_RIGHT, "right")):
+            if pressed & bit:
+                wanted.append(("turn " + side, lambda f, side=side: f[3] == side))
+        for name, drawn in wanted:
+            delay = None
+            for ahead in range(index, min(index + LOST, len(frames))):
+                if drawn(frames[ahead]):
+                    delay = ahead - index
+                    break
+            events.append((number, name, delay))
+
+    print("%6s %-10s %s" % ("frame", "input", "frames until drawn"))
+    for number, name, delay in events:
+        print("%6d %-10s %s" % (number, name, "lost" if delay is None else delay))
+    drawn = [d for _, _, d in events if d is not None]
+    if drawn:
+        print("%d inputs, %d lost, latency avg %.2f max %d frames"
+              % (len(events), len(events) - len(drawn), sum(drawn) / len(drawn), max(drawn)))
+    return 1 if len(drawn) != len(events) else 0
+
+# ---------------------------------------------------------------------------
+
+
+def main():
+    parser = argparse.ArgumentParser(description="beam trace analyser")
+    parser.add_argument("command", choices=["report", "compare", "latency"])
+    parser.add_argument("files", nargs="+")
+    parser.add_argument("--rom", help="cartridge binary the trace was recorded with")
+    parser.add_argument("--map", help="linker map, needed for latency")
+    args = parser.parse_args()
+
+    rom = open(args.rom, "rb").read() if args.rom else None
+    if args.command == "report":
+        for path in args.files:
+            report(load(path, rom))
+        return 0
+    if args.command == "latency":
+        if not args.map:
+            parser.error("latency needs --map")
+        found = symbols(args.map, ("vectors_pyoro_left", "vectors_pyoro_right"))
+        sprites = {found["vectors_pyoro_left"]: "left", found["vectors_pyoro_right"]: "right"}
+        return max(latency(path, sprites) for path in args.files)
+    if len(args.files) != 2:
+        parser.error("compare needs GOLDEN and TRACE")
+    return compare(load(args.files[0], rom), load(args.files[1], rom))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+
+# ***************************************************************************
+# end of file
+# ***************************************************************************
@@ -0,0 +1,330 @@
+# ***************************************************************************
+# wcet - static worst case execution time of a frame
+# ***************************************************************************
+#
+# builds the call graph from the compiled .s files in build\lib, annotates
+# every instruction with its 6809 cycle count (written next to the source
+# as build\lib\*.cyc) and reports the worst case path through the entry
+# function; bios routines, library calls and loop bounds come from
+# tools\wcet.txt
+#
+# the entry defaults to game_frame, one frame of the game in any state;
+# calls through a pointer (the state table) cost as much as the worst of
+# the targets listed for the calling function
+#
+# the game logic ticks of a frame are the define TICKS: a frame with one
+# tick must fit into the 50 Hz budget of 30000 cycles (the default run),
+# the frame with two ticks that utils/pace.h allows at the longest refresh
+# period must fit into 33750 cycles; make.bat checks both in two runs
+#
+# loop bounds that depend on a build switch (LANES) are names defined in
+# wcet.txt; make.bat passes its compiler options with --options, so a
+# build with -D LANES=30 is checked with the bounds of 30 lanes
+#
+# usage:
+#   python tools\wcet.py [--build build\lib] [--entry game_frame]
+#                        [--budget 30000] [--options="-O0 -D LANES=30"]
+#                        [-D NAME=VALUE] [--functions]
+#
+# exits with 1 if the worst case is over budget or the code cannot be
+# bounded (unknown call, unbounded loop, recursion)
+
+import argparse
+import os
+import sys
+
+import asm6809
+
+TOOLS = os.path.dirname(os.path.abspath(__file__))
+
+# ---------------------------------------------------------------------------
+# bounds file
+#   bios NAME ADDRESS CYCLES STACK   cost of a bios routine (called by name or address)
+#   call NAME CYCLES STACK           cost of a library routine
+#   define NAME EXPRESSION           value of a build switch or a value derived
+#                                    from one, unless given on the command line
+#   loop FUNCTION N COUNT            bound of the n-th loop (1 = first) in FUNCTION,
+#                                    COUNT is a number or an expression of defines
+#   indirect FUNCTION TARGET ...     functions FUNCTION may call through a pointer
+#   task FUNCTION                    jmp through a pointer in FUNCTION is a computed
+#                                    goto to one of its own labels (utils/task.h)
+
+
+def defines(options):
+    # -D NAME=VALUE and -DNAME=VALUE of a compiler option string
+    found = {}
+    words = options.split()
+    for index, word in enumerate(words):
+        if word == "-D" and index + 1 < len(words):
+            word = words[index + 1]
+        elif word.startswith("-D"):
+            word = word[2:]
+        else:
+            continue
+        name, _, value = word.partition("=")
+        found[name] = value or "1"
+    return found
+
+
+class Bounds:
+    def __init__(self, path, switches=None):
+        self.defines = {}
+        for name, value in (switches or {}).items():
+            self.defines[name] = self.evaluate(value, path, 0)
+        self.calls = {}
+        self.stack = {}
+        self.loops = {}
+        self.indirect = {}
+        self.tasks = set()
+        for number, line in enumerate(open(path), 1):
+            fields = line.split("#", 1)[0].split()
+            if not fields:
+                continue
+            kind = fields[0]
+            if kind == "bios":
+                for key in (fields[1], "0x" + fields[2].lower(), "$" + fields[2].lower()):
+                    self.calls[key] = int(fields[3])
+                    self.stack[key] = int(fields[4])
+            elif kind == "call":
+                self.calls[fields[1]] = int(fields[2])
+                self.stack[fields[1]] = int(fields[3])
+            elif kind == "define":
+                if fields[1] not in self.defines:
+                    self.defines[fields[1]] = self.evaluate(" ".join(fields[2:]), path, number)
+            elif kind == "loop":
+                self.loops[(fields[1], int(fields[2]))] = self.evaluate(" ".join(fields[3:]), path, number)
+            elif kind == "indirect":
+                self.indirect.setdefault(fields[1], []).extend(fields[2:])
+            elif kind == "task":
+                self.tasks.add(fields[1])
+            else:
+                raise SystemExit("%s:%d: unknown bound '%s'" % (path, number, kind))
+
+    def evaluate(self, expression, path, number):
+        # integer arithmetic on numbers and defines, / truncates as in c
+        try:
+            return int(eval(expression.replace("/", "//"), {"__builtins__": {}}, self.defines))
+        except Exception:
+            raise SystemExit("%s:%d: cannot evaluate '%s'" % (path, number, expression))
+
+    def call(self, name):
+        return self.lookup(self.calls, name)
+
+    def stack_use(self, name):
+        return self.lookup(self.stack, name)
+
+    @staticmethod
+    def lookup(table, name):
+        for key in (name, name.lstrip("_"), name.lower()):
+            if key in table:
+                return table[key]
+        return None
+
+# ---------------------------------------------------------------------------
+
+
+class Analysis:
+    def __init__(self, functions, bounds):
+        self.functions = functions
+        self.bounds = bounds
+        self.cost = {}
+        self.path = {}
+        self.resume = {}
+        self.active = set()
+        self.errors = []
+
+    def callee(self, target, caller):
+        if asm6809.Instruction("jsr", target, "", 0).indirect():
+            targets = self.bounds.indirect.get(caller)
+            if not targets:
+                self.errors.append("no targets for call through '%s' in '%s'" % (target, caller))
+                return 0, []
+            return max((self.callee(t, caller) for t in targets), key=lambda c: c[0])
+        name = target[1:] if target.startswith("_") else target
+        if name in self.functions:
+            return self.function(name), [name]
+        cost = self.bounds.call(target)
+        if cost is None:
+            self.errors.append("no bound for call to '%s'" % target)
+            return 0, []
+        return cost, [target.lstrip("_")]
+
+    def function(self, name):
+        if name in self.cost:
+            return self.cost[name]
+        if name in self.active:
+            self.errors.append("recursion through '%s'" % name)
+            return 0
+        self.active.add(name)
+        function = self.functions[name]
+        code = []
+        labels = {}
+        for kind, item in function.items:
+            if kind == "label":
+                labels[item] = len(code)
+            else:
+                code.append(item)
+        if name in self.bounds.tasks:
+            self.resume[name] = sorted(labels[l] for l in function.taken_labels())
+
+        # loops are back edges, numbered in source order of their header
+        loops = {}
+        for index, insn in enumerate(code):
+            branch = insn.branch()
+            if branch and branch[0] in labels and labels[branch[0]] <= index:
+                head = labels[branch[0]]
+                loops[head] = max(loops.get(head, index), index)
+        order = sorted(loops)
+        for number, head in enumerate(order, 1):
+            if (name, number) not in self.bounds.loops:
+                self.errors.append("no bound for loop %d in '%s' (line %d)"
+                                   % (number, name, code[head].line))
+        bound = {head: self.bounds.loops.get((name, n), 1) for n, head in enumerate(order, 1)}
+
+        cost, path = self.region(name, code, labels, loops, bound, 0, len(code), None)
+        self.active.discard(name)
+        self.cost[name] = cost
+        self.path[name] = path
+        return cost
+
+    def region(self, name, code, labels, loops, bound, start, end, head):
+        # longest path through code[start:end]; inside a loop body, branches
+        # back to head end the iteration
+        dist = {start: (0, [])}
+        best = (0, [])
+
+        def reach(index, value, source):
+            # gcc rotates while loops and enters them with a jump to the
+            # condition at the bottom, count such entries from the header
+            for first in sorted(loops):
+                if first < index <= loops[first] and not first <= source <= loops[first]:
+                    index = first
+                    break
+            if index not in dist or dist[index][0] < value[0]:
+                dist[index] = value
+
+        index = start
+        while index < end:
+            if index not in dist:
+                index += 1
+                continue
+            here, path = dist[index]
+            if index in loops and index != head:
+                last = loops[index]
+                body, inner = self.region(name, code, labels, loops, bound, index, last + 1, index)
+                value = (here + body * bound[index], path + inner)
+                reach(last + 1, value, index)
+                for k in range(index, last + 1):
+                    target = code[k].branch()
+                    if target and target[0] in labels and labels[target[0]] > last:
+                        reach(labels[target[0]], value, k)
+                index = last + 1
+                continue
+            insn = code[index]
+            if insn.mnemonic == "jmp" and insn.indirect() and name in self.resume:
+                # computed goto of a task, continues at any resume point
+                for position in self.resume[name]:
+                    if position <= index:
+                        self.errors.append("'%s' line %d: resume point above the goto"
+                                           % (name, insn.line))
+                    reach(position, (here + insn.cycles, path), index)
+                index += 1
+                continue
+            cost = insn.cycles
+            calls = path
+            target = insn.call()
+            if target is not None:
+                extra, callee = self.callee(target, name)
+                cost += extra
+                calls = path + callee
+            value = (here + cost, calls)
+            branch = insn.branch()
+            if branch:
+                label, conditional = branch
+                if label in labels:
+                    position = labels[label]
+                    if head is not None and position == head:
+                        best = max(best, value, key=lambda v: v[0])
+                    elif position > index:
+                        reach(position, value, index)
+                if conditional:
+                    reach(index + 1, value, index)
+            elif insn.returns():
+                best = max(best, value, key=lambda v: v[0])
+            else:
+                reach(index + 1, value, index)
+            index += 1
+        if end in dist:
+            best = max(best, dist[end], key=lambda v: v[0])
+        return best
+
+# ---------------------------------------------------------------------------
+
+
+def annotate(folder, functions):
+    for module in sorted({f.module for f in functions.values()}):
+        source = os.path.join(folder, module + ".s")
+        cycles = {}
+        for function in functions.values():
+            if function.module == module:
+                for insn in function.instructions():
+                    cycles[insn.line] = insn.cycles
+        with open(os.path.join(folder, module + ".cyc"), "w") as out:
+            for number, line in enumerate(open(source, encoding="latin-1"), 1):
+                mark = "[%3d]" % cycles[number] if number in cycles else "     "
+                out.write("%s %s" % (mark, line))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="static worst case frame time")
+    parser.add_argument("--build", default=os.path.join("build", "lib"))
+    parser.add_argument("--bounds", default=os.path.join(TOOLS, "wcet.txt"))
+    parser.add_argument("--entry", default="game_frame")
+    parser.add_argument("--budget", type=int, default=30000,
+                        help="cycles per frame, 30000 = one game logic tick at 50 Hz (utils/pace.h)")
+    parser.add_argument("--options", default="",
+                        help="compiler options of the build, its -D switches select the bounds")
+    parser.add_argument("-D", dest="define", action="append", default=[],
+                        metavar="NAME=VALUE", help="set a define of the bounds file")
+    parser.add_argument("--functions", action="store_true",
+                        help="list the worst case of every function")
+    args = parser.parse_args()
+
+    functions = asm6809.read_build(args.build)
+    if args.entry not in functions:
+        raise SystemExit("entry '%s' not found in %s" % (args.entry, args.build))
+    annotate(args.build, functions)
+
+    switches = defines(args.options)
+    switches.update(defines(" ".join("-D" + d for d in args.define)))
+    bounds = Bounds(args.bounds, switches)
+    analysis = Analysis(functions, bounds)
+    worst = analysis.function(args.entry)
+    if args.functions:
+        for name in sorted(functions):
+            print("%8d  %s" % (analysis.function(name), name))
+        print()
+    for error in sorted(set(analysis.errors)):
+        print("error: %s" % error)
+
+    print("worst case path through %s:" % args.entry)
+    for name in analysis.path[args.entry]:
+        cost = analysis.cost.get(name, analysis.bounds.call(name))
+        print("  %8s  %s" % (cost if cost is not None else "?", name))
+    print("wcet %d cycles, budget %d cycles (%d%%), %s"
+          % (worst, args.budget, worst * 100 // args.budget,
+             " ".join("%s=%d" % d for d in sorted(bounds.defines.items()))))
+    if analysis.errors:
+        return 1
+    if worst > args.budget:
+        print("error: worst case frame is over budget by %d cycles" % (worst - args.budget))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+
+# ***************************************************************************
+# end of file
+# ***************************************************************************